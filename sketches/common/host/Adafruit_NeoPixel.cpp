@@ -0,0 +1,83 @@
+#include "Adafruit_NeoPixel.h"
+
+#include <math.h>
+
+void (*Adafruit_NeoPixel::showHook)(const Adafruit_NeoPixel& strip) = NULL;
+
+Adafruit_NeoPixel::Adafruit_NeoPixel(uint16_t count, int16_t pin, uint16_t type)
+  : count(count), brightness(255), frameCount(0) {
+  (void)pin;
+  (void)type;
+  pixels = static_cast<uint32_t*>(calloc(count ? count : 1, sizeof(uint32_t)));
+}
+
+Adafruit_NeoPixel::~Adafruit_NeoPixel() {
+  free(pixels);
+}
+
+void Adafruit_NeoPixel::show() {
+  frameCount++;
+  if (showHook) showHook(*this);
+}
+
+void Adafruit_NeoPixel::clear() {
+  memset(pixels, 0, count * sizeof(uint32_t));
+}
+
+void Adafruit_NeoPixel::setPixelColor(uint16_t n, uint32_t color) {
+  if (n < count) pixels[n] = color & 0xFFFFFF;
+}
+
+void Adafruit_NeoPixel::setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b) {
+  setPixelColor(n, Color(r, g, b));
+}
+
+uint32_t Adafruit_NeoPixel::getPixelColor(uint16_t n) const {
+  return n < count ? pixels[n] : 0;
+}
+
+// Same hue wheel as the Adafruit library (six 255-step segments)
+uint32_t Adafruit_NeoPixel::ColorHSV(uint16_t hue, uint8_t sat, uint8_t val) {
+  uint8_t r, g, b;
+  uint32_t h = ((uint32_t)hue * 1530UL + 32768UL) / 65536UL;
+  
+  if (h < 510) {
+    b = 0;
+    if (h < 255) { r = 255; g = h; } else { r = 510 - h; g = 255; }
+  } else if (h < 1020) {
+    r = 0;
+    if (h < 765) { g = 255; b = h - 510; } else { g = 1020 - h; b = 255; }
+  } else if (h < 1530) {
+    g = 0;
+    if (h < 1275) { r = h - 1020; b = 255; } else { r = 255; b = 1530 - h; }
+  } else {
+    r = 255; g = b = 0;
+  }
+  
+  uint32_t v1 = 1 + val;
+  uint16_t s1 = 1 + sat;
+  uint8_t s2 = 255 - sat;
+  return ((((((r * s1) >> 8) + s2) * v1) & 0xFF00) << 8) |
+         (((((g * s1) >> 8) + s2) * v1) & 0xFF00) |
+         (((((b * s1) >> 8) + s2) * v1) >> 8);
+}
+
+// The library reads gamma8() from a 256-byte table; so does the stand-in,
+// to keep its cost comparable in host benchmarks
+uint8_t Adafruit_NeoPixel::gamma8(uint8_t x) {
+  static uint8_t table[256];
+  static bool ready = false;
+  if (!ready) {
+    for (int i = 0; i < 256; i++) {
+      table[i] = (uint8_t)(pow(i / 255.0, 2.6) * 255.0 + 0.5);
+    }
+    ready = true;
+  }
+  return table[x];
+}
+
+uint32_t Adafruit_NeoPixel::gamma32(uint32_t color) {
+  return ((uint32_t)gamma8((color >> 16) & 0xFF) << 16) |
+         ((uint32_t)gamma8((color >> 8) & 0xFF) << 8) |
+         gamma8(color & 0xFF);
+}
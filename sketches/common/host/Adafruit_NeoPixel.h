@@ -0,0 +1,50 @@
+#ifndef HOST_ADAFRUIT_NEOPIXEL_H
+#define HOST_ADAFRUIT_NEOPIXEL_H
+
+/**
+ * Adafruit_NeoPixel stand-in for host builds
+ * Keeps the pixel buffer in memory and records every show() as a frame:
+ * the simulator reads frame counts and contents instead of driving WS2812s.
+ * Pixels are stored as 0x00RRGGBB before brightness scaling.
+ */
+
+#include "Arduino.h"
+
+#define NEO_GRB 0x52
+#define NEO_KHZ800 0x0000
+
+class Adafruit_NeoPixel {
+public:
+  Adafruit_NeoPixel(uint16_t count, int16_t pin, uint16_t type);
+  ~Adafruit_NeoPixel();
+  
+  void begin() {}
+  void show();
+  void clear();
+  void setBrightness(uint8_t value) { brightness = value; }
+  uint8_t getBrightness() const { return brightness; }
+  
+  void setPixelColor(uint16_t n, uint32_t color);
+  void setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b);
+  uint32_t getPixelColor(uint16_t n) const;
+  uint16_t numPixels() const { return count; }
+  
+  static uint32_t Color(uint8_t r, uint8_t g, uint8_t b) {
+    return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+  }
+  static uint32_t ColorHSV(uint16_t hue, uint8_t sat = 255, uint8_t val = 255);
+  static uint8_t gamma8(uint8_t x);
+  static uint32_t gamma32(uint32_t color);
+  
+  // Frames shown by this strip, and a hook run after each show() (NULL = off)
+  unsigned long frames() const { return frameCount; }
+  static void (*showHook)(const Adafruit_NeoPixel& strip);
+
+private:
+  uint16_t count;
+  uint32_t* pixels;
+  uint8_t brightness;
+  unsigned long frameCount;
+};
+
+#endif // HOST_ADAFRUIT_NEOPIXEL_H
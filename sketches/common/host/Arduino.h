@@ -0,0 +1,55 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+/**
+ * Minimal Arduino core for host builds (sketches/common/host)
+ * Provides just what sketches/common/src uses: timing, digital pins and a
+ * Serial object. Timing is real (CLOCK_MONOTONIC since start-up); pin
+ * writes are recorded so the simulator can report them.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define LED_BUILTIN 13
+
+#define HOST_PIN_COUNT 64
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int value);
+int digitalRead(int pin);
+
+// Called after every digitalWrite() that changes a pin (NULL = off)
+extern void (*hostPinHook)(int pin, int value);
+
+/**
+ * Serial stand-in: accepts and discards output, never has input.
+ * The simulator talks through PosixTransport instead.
+ */
+class HostSerial {
+public:
+  void begin(unsigned long) {}
+  void end() {}
+  int available() { return 0; }
+  int read() { return -1; }
+  int availableForWrite() { return 64; }
+  size_t write(uint8_t) { return 1; }
+  size_t write(const uint8_t*, size_t length) { return length; }
+  void flush() {}
+  operator bool() { return true; }
+};
+
+extern HostSerial Serial;
+extern HostSerial Serial1;
+
+#endif // HOST_ARDUINO_H
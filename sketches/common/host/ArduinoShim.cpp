@@ -0,0 +1,49 @@
+#include "Arduino.h"
+
+#include <time.h>
+
+HostSerial Serial;
+HostSerial Serial1;
+
+void (*hostPinHook)(int pin, int value) = NULL;
+
+static uint8_t pinStates[HOST_PIN_COUNT];
+
+static uint64_t monotonicMicros() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+static const uint64_t startMicros = monotonicMicros();
+
+// Both wrap like the 32-bit counters on the boards
+unsigned long millis() {
+  return (unsigned long)(uint32_t)((monotonicMicros() - startMicros) / 1000ULL);
+}
+
+unsigned long micros() {
+  return (unsigned long)(uint32_t)(monotonicMicros() - startMicros);
+}
+
+void delay(unsigned long ms) {
+  struct timespec ts = { (time_t)(ms / 1000), (long)(ms % 1000) * 1000000L };
+  nanosleep(&ts, NULL);
+}
+
+void pinMode(int pin, int mode) {
+  (void)pin;
+  (void)mode;
+}
+
+void digitalWrite(int pin, int value) {
+  if (pin < 0 || pin >= HOST_PIN_COUNT) return;
+  uint8_t state = value ? HIGH : LOW;
+  if (pinStates[pin] == state) return;
+  pinStates[pin] = state;
+  if (hostPinHook) hostPinHook(pin, state);
+}
+
+int digitalRead(int pin) {
+  return pin >= 0 && pin < HOST_PIN_COUNT ? pinStates[pin] : LOW;
+}
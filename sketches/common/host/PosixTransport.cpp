@@ -0,0 +1,115 @@
+#include "PosixTransport.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+// Reported by availableForWrite() while the fd accepts data
+#define POSIX_WRITE_CHUNK 256
+
+PosixTransport::PosixTransport(int inFd, int outFd)
+  : inFd(inFd), outFd(outFd), ptySlaveFd(-1), readPos(0), readLength(0), closed(false),
+    corruptEvery(0), bytesRead(0) {
+  ptyPath[0] = '\0';
+}
+
+PosixTransport::~PosixTransport() {
+  if (ptySlaveFd >= 0) {
+    close(ptySlaveFd);
+    close(inFd);  // Master side, shared by inFd and outFd
+  }
+}
+
+bool PosixTransport::openPty() {
+  int master = posix_openpt(O_RDWR | O_NOCTTY);
+  if (master < 0) return false;
+  if (grantpt(master) != 0 || unlockpt(master) != 0 || !ptsname(master)) {
+    close(master);
+    return false;
+  }
+  snprintf(ptyPath, sizeof(ptyPath), "%s", ptsname(master));
+  
+  // Raw bytes both ways, like a USB CDC port
+  ptySlaveFd = open(ptyPath, O_RDWR | O_NOCTTY);
+  if (ptySlaveFd < 0) {
+    close(master);
+    ptyPath[0] = '\0';
+    return false;
+  }
+  struct termios settings;
+  if (tcgetattr(ptySlaveFd, &settings) == 0) {
+    cfmakeraw(&settings);
+    tcsetattr(ptySlaveFd, TCSANOW, &settings);
+  }
+  
+  inFd = outFd = master;
+  readPos = readLength = 0;
+  return true;
+}
+
+void PosixTransport::begin(long baudRate) {
+  (void)baudRate;
+}
+
+void PosixTransport::end() {
+}
+
+bool PosixTransport::fillReadBuffer() {
+  if (readPos < readLength) return true;
+  
+  struct pollfd pfd = { inFd, POLLIN, 0 };
+  if (poll(&pfd, 1, 0) <= 0 || !(pfd.revents & (POLLIN | POLLHUP))) return false;
+  
+  ssize_t n = ::read(inFd, readBuffer, sizeof(readBuffer));
+  if (n <= 0) {
+    if (n == 0 || errno != EINTR) closed = true;  // EOF (a pty never reports one)
+    return false;
+  }
+  readPos = 0;
+  readLength = (uint16_t)n;
+  return true;
+}
+
+int PosixTransport::available() {
+  return fillReadBuffer() ? readLength - readPos : 0;
+}
+
+int PosixTransport::read() {
+  if (!fillReadBuffer()) return -1;
+  uint8_t byte = readBuffer[readPos++];
+  if (corruptEvery && ++bytesRead % corruptEvery == 0) byte ^= 0x01;
+  return byte;
+}
+
+int PosixTransport::availableForWrite() {
+  struct pollfd pfd = { outFd, POLLOUT, 0 };
+  return poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLOUT) ? POSIX_WRITE_CHUNK : 0;
+}
+
+size_t PosixTransport::write(const uint8_t* data, size_t length) {
+  size_t written = 0;
+  while (written < length) {
+    ssize_t n = ::write(outFd, data + written, length - written);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      break;
+    }
+    written += (size_t)n;
+  }
+  return written;
+}
+
+void PosixTransport::waitForInput(int timeoutMs) {
+  if (closed || readPos < readLength) return;
+  struct pollfd pfd = { inFd, POLLIN, 0 };
+  poll(&pfd, 1, timeoutMs);
+}
+
+void PosixTransport::flush() {
+  if (isatty(outFd)) tcdrain(outFd);
+}
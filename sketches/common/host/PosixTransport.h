@@ -0,0 +1,60 @@
+#ifndef POSIX_TRANSPORT_H
+#define POSIX_TRANSPORT_H
+
+#include "Transport.h"
+
+/**
+ * Transport for Linux host builds of the firmware
+ * Runs over a pair of file descriptors (stdin/stdout by default) or over a
+ * pseudo-terminal that host tools such as src/controller.js open like a
+ * real serial port. Reads never block; writes go straight to the fd.
+ */
+class PosixTransport : public Transport {
+public:
+  PosixTransport(int inFd = 0, int outFd = 1);
+  ~PosixTransport() override;
+  
+  // Create a pty and use its master side; portPath() names the port to open
+  bool openPty();
+  const char* portPath() const { return ptyPath; }
+  
+  // Lifecycle (rates have no meaning here; end() keeps the link open so a
+  // BAUD switch does not drop the port)
+  void begin(long baudRate) override;
+  void end() override;
+  
+  // Receive
+  int available() override;
+  int read() override;
+  
+  // Transmit
+  int availableForWrite() override;
+  size_t write(const uint8_t* data, size_t length) override;
+  void flush() override;
+  
+  // Host loop helpers: sleep until input arrives (or timeoutMs passes), and
+  // whether the input side has reached end of file
+  void waitForInput(int timeoutMs);
+  bool inputClosed() const { return closed; }
+  
+  // Fault injection: flip the low bit of every nth byte received (0 = off)
+  void setCorruptEvery(unsigned long n) { corruptEvery = n; }
+
+private:
+  int inFd;
+  int outFd;
+  int ptySlaveFd;  // Held open so the master survives host reconnects
+  char ptyPath[64];
+  
+  // Bytes read from the fd but not yet consumed
+  uint8_t readBuffer[256];
+  uint16_t readPos;
+  uint16_t readLength;
+  bool closed;
+  unsigned long corruptEvery;
+  unsigned long bytesRead;
+  
+  bool fillReadBuffer();
+};
+
+#endif // POSIX_TRANSPORT_H
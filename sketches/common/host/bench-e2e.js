@@ -0,0 +1,127 @@
+#!/usr/bin/env node
+/**
+ * @fileoverview End-to-end benchmark: src/controller.js against cc-led-sim
+ *
+ * Starts the host simulator, opens its pty with LedController exactly like
+ * a board's serial port, and measures the whole stack (host encoder, pty,
+ * firmware decode/queue/execute/respond):
+ *   - latency:   one tagged command at a time, round-trip percentiles
+ *   - pipelined: sendPipelined() with a 16-command window
+ *   - streamed:  quiet mode + flow control, sendNoWait() until a final PING
+ *   - reliable:  sendReliable() over the device window, on a clean link and
+ *                on a second simulator that corrupts every LOSSY_EVERY-th byte
+ *
+ * Usage: node bench-e2e.js [--sim ./cc-led-sim] [--count n] [--json file]
+ */
+
+import { spawn } from 'child_process';
+import { writeFileSync } from 'fs';
+import { createInterface } from 'readline';
+import { LedController } from '../../../src/controller.js';
+
+const COMMANDS = ['COLOR,255,0,0', 'OFF', 'BLINK1,0,0,255,200', 'RAINBOW,50', 'ON'];
+const LOSSY_EVERY = 97;
+
+function parseArgs(argv) {
+  const options = { sim: './cc-led-sim', count: 2000, json: null };
+  for (let i = 2; i + 1 < argv.length; i += 2) {
+    const key = argv[i].replace(/^--/, '');
+    if (!(key in options)) throw new Error(`Unknown option ${argv[i]}`);
+    options[key] = key === 'count' ? Number(argv[i + 1]) : argv[i + 1];
+  }
+  return options;
+}
+
+// Start the simulator and wait for the pty path on its first stdout line
+function startSimulator(path, args = []) {
+  const sim = spawn(path, args, { stdio: ['ignore', 'pipe', 'inherit'] });
+  return new Promise((resolve, reject) => {
+    sim.on('error', reject);
+    createInterface({ input: sim.stdout }).once('line', (port) => resolve({ sim, port }));
+  });
+}
+
+function percentile(sorted, p) {
+  return sorted[Math.min(sorted.length - 1, Math.floor(sorted.length * p))];
+}
+
+async function measureReliable(controller, commands) {
+  const start = process.hrtime.bigint();
+  await controller.sendReliable(commands);
+  return commands.length / (Number(process.hrtime.bigint() - start) / 1e9);
+}
+
+async function main() {
+  const options = parseArgs(process.argv);
+  const { sim, port } = await startSimulator(options.sim);
+  const lossy = await startSimulator(options.sim, ['--corrupt', String(LOSSY_EVERY)]);
+  const controller = new LedController(port);
+  const lossyController = new LedController(lossy.port);
+  const commands = Array.from({ length: options.count }, (_, i) => COMMANDS[i % COMMANDS.length]);
+
+  // The controller logs every command; keep the measurements quiet
+  const log = console.log;
+  console.log = () => {};
+  const results = {};
+
+  try {
+    await controller.connect();
+
+    const latencies = [];
+    for (const command of commands) {
+      const start = process.hrtime.bigint();
+      await controller.sendPipelined([command], { window: 1 });
+      latencies.push(Number(process.hrtime.bigint() - start) / 1000);
+    }
+    latencies.sort((a, b) => a - b);
+    results.latency_us = {
+      p50: percentile(latencies, 0.5),
+      p99: percentile(latencies, 0.99),
+      max: latencies[latencies.length - 1]
+    };
+
+    let start = process.hrtime.bigint();
+    await controller.sendPipelined(commands, { window: 16 });
+    results.pipelined_commands_per_s = options.count / (Number(process.hrtime.bigint() - start) / 1e9);
+
+    await controller.setQuietMode(true);
+    await controller.setFlowControl(true);
+    start = process.hrtime.bigint();
+    for (const command of commands) {
+      await controller.sendNoWait(command);
+    }
+    await controller.ping();  // Answered after everything before it has run
+    results.streamed_commands_per_s = options.count / (Number(process.hrtime.bigint() - start) / 1e9);
+    results.stats = await controller.getStats();
+
+    await controller.setReliableMode(true);
+    results.reliable_commands_per_s = await measureReliable(controller, commands);
+
+    await lossyController.connect();
+    await lossyController.setReliableMode(true);
+    results.reliable_lossy_commands_per_s = await measureReliable(lossyController, commands);
+    results.reliable_lossy_retransmits = lossyController.retransmits;
+  } finally {
+    console.log = log;
+    await controller.disconnect();
+    await lossyController.disconnect();
+    sim.kill('SIGTERM');
+    lossy.sim.kill('SIGTERM');
+  }
+
+  console.log(`latency p50 ${results.latency_us.p50.toFixed(0)} us, p99 ${results.latency_us.p99.toFixed(0)} us`);
+  console.log(`pipelined ${results.pipelined_commands_per_s.toFixed(0)} commands/s`);
+  console.log(`streamed  ${results.streamed_commands_per_s.toFixed(0)} commands/s`);
+  console.log(`reliable  ${results.reliable_commands_per_s.toFixed(0)} commands/s, ` +
+    `${results.reliable_lossy_commands_per_s.toFixed(0)} commands/s with 1 in ${LOSSY_EVERY} bytes corrupted ` +
+    `(${results.reliable_lossy_retransmits} retransmits)`);
+  if (options.json) {
+    writeFileSync(options.json, `${JSON.stringify({ count: options.count, ...results }, null, 2)}\n`);
+    console.log(`Results written to ${options.json}`);
+  }
+}
+
+main().catch((error) => {
+  console.error(error.message);
+  process.exit(1);
+});
@@ -0,0 +1,137 @@
+/**
+ * Rainbow kernel benchmark (host only)
+ *
+ * Renders rainbow frames into a FrameBuffer two ways and reports the cost
+ * per pixel for 1-, 60- and 300-pixel strips:
+ *   - adafruit: gamma32(ColorHSV(hue)) per pixel, as RAINBOW used to
+ *   - table:    colorRainbowFill(), the hue wheel and gamma tables
+ * It also checks the tables against the Adafruit routines over every hue:
+ * exact at each wheel position, within a few steps in between.
+ *
+ * Usage: bench-rainbow [--pixels-total n] [--json file]   (make bench-rainbow)
+ */
+#include "Adafruit_NeoPixel.h"
+#include <ColorTables.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static const uint16_t STRIP_SIZES[] = { 1, 60, 300 };
+#define STRIP_COUNT (sizeof(STRIP_SIZES) / sizeof(STRIP_SIZES[0]))
+#define MAX_STRIP 300
+
+struct Result {
+  uint16_t pixels;
+  double adafruitNs;
+  double tableNs;
+};
+
+static uint8_t storage[MAX_STRIP * 3];
+static volatile uint32_t sink;  // Keeps the rendered frames observable
+
+static double nowNs() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static uint32_t checksum(const FrameBuffer& fb) {
+  uint32_t sum = 0;
+  for (uint32_t i = 0; i < (uint32_t)fb.count * 3; i++) sum = sum * 31 + fb.data[i];
+  return sum;
+}
+
+static void renderAdafruit(FrameBuffer* fb, uint16_t baseHue) {
+  for (uint16_t i = 0; i < fb->count; i++) {
+    uint16_t hue = (uint16_t)(baseHue + (uint32_t)i * 65536 / fb->count);
+    uint32_t rgb = Adafruit_NeoPixel::gamma32(Adafruit_NeoPixel::ColorHSV(hue));
+    frameBufferSet(fb, i, (uint8_t)(rgb >> 16), (uint8_t)(rgb >> 8), (uint8_t)rgb);
+  }
+}
+
+static void renderTable(FrameBuffer* fb, uint16_t baseHue) {
+  colorRainbowFill(fb, baseHue);
+}
+
+// Nanoseconds per pixel over enough frames to render totalPixels pixels
+static double measure(void (*render)(FrameBuffer*, uint16_t), uint16_t pixels, long totalPixels) {
+  FrameBuffer fb;
+  frameBufferInit(&fb, storage, pixels);
+  long frames = totalPixels / pixels;
+
+  double start = nowNs();
+  for (long frame = 0; frame < frames; frame++) {
+    render(&fb, (uint16_t)(frame * 256));
+  }
+  double elapsed = nowNs() - start;
+  sink += checksum(fb);
+  return elapsed / ((double)frames * pixels);
+}
+
+// Largest channel difference from gamma32(ColorHSV()) over all hues, and
+// whether the 256 wheel positions match exactly
+static int maxHueError(bool* wheelExact) {
+  int worst = 0;
+  *wheelExact = true;
+  for (uint32_t hue = 0; hue < 65536; hue++) {
+    uint32_t expected = Adafruit_NeoPixel::gamma32(Adafruit_NeoPixel::ColorHSV((uint16_t)hue));
+    uint8_t rgb[3];
+    colorHue((uint16_t)hue, &rgb[0], &rgb[1], &rgb[2]);
+    for (int c = 0; c < 3; c++) {
+      int diff = abs((int)((expected >> (16 - 8 * c)) & 0xFF) - rgb[c]);
+      if (diff > worst) worst = diff;
+      if (diff != 0 && (hue & 0xFF) == 0) *wheelExact = false;
+    }
+  }
+  return worst;
+}
+
+int main(int argc, char** argv) {
+  long totalPixels = 6000000;
+  const char* jsonPath = NULL;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "--pixels-total") == 0) {
+      totalPixels = atol(argv[i + 1]);
+    } else if (strcmp(argv[i], "--json") == 0) {
+      jsonPath = argv[i + 1];
+    } else {
+      fprintf(stderr, "Usage: %s [--pixels-total n] [--json file]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  bool wheelExact;
+  int worst = maxHueError(&wheelExact);
+
+  Result results[STRIP_COUNT];
+  printf("Rainbow kernel, %ld pixels per case (ns per pixel)\n", totalPixels);
+  printf("pixels      adafruit         table       speedup\n");
+  for (size_t i = 0; i < STRIP_COUNT; i++) {
+    results[i].pixels = STRIP_SIZES[i];
+    results[i].adafruitNs = measure(renderAdafruit, STRIP_SIZES[i], totalPixels);
+    results[i].tableNs = measure(renderTable, STRIP_SIZES[i], totalPixels);
+    printf("%-6u %13.2f %13.2f %12.1fx\n", results[i].pixels, results[i].adafruitNs,
+           results[i].tableNs, results[i].adafruitNs / results[i].tableNs);
+  }
+  printf("max channel error vs gamma32(ColorHSV()): %d (wheel positions %s)\n",
+         worst, wheelExact ? "exact" : "DIFFER");
+
+  if (jsonPath) {
+    FILE* out = fopen(jsonPath, "w");
+    if (!out) {
+      perror(jsonPath);
+      return 1;
+    }
+    fprintf(out, "{\n  \"pixelsPerCase\": %ld,\n  \"maxChannelError\": %d,\n  \"cases\": [\n", totalPixels, worst);
+    for (size_t i = 0; i < STRIP_COUNT; i++) {
+      fprintf(out, "    { \"pixels\": %u, \"adafruitNsPerPixel\": %.2f, \"tableNsPerPixel\": %.2f }%s\n",
+              results[i].pixels, results[i].adafruitNs, results[i].tableNs, i + 1 < STRIP_COUNT ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+    fclose(out);
+  }
+
+  return wheelExact ? 0 : 1;
+}
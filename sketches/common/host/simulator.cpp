@@ -0,0 +1,125 @@
+/**
+ * Host-native firmware simulator
+ *
+ * Runs the unmodified firmware loop (UniversalMain, SerialCommandHandler,
+ * CommandProcessor, LED controllers) on Linux. By default it creates a
+ * pseudo-terminal and prints its path as the first line of stdout; open
+ * that path like a board's serial port. With --stdio commands are read
+ * from stdin and responses written to stdout, and the simulator exits
+ * once stdin is closed and every response has been written.
+ *
+ * With --corrupt n every nth received byte has a bit flipped, for
+ * exercising reliable mode (RELIABLE,1) over a lossy link.
+ *
+ * Usage: cc-led-sim [--stdio] [--led neopixel|digital] [--pixels n] [--corrupt n] [--trace]
+ */
+#include "Arduino.h"
+#include "Adafruit_NeoPixel.h"
+#include "PosixTransport.h"
+#include <UniversalMain.h>
+#include <NeoPixelLEDController.h>
+#include <DigitalLEDController.h>
+
+#include <signal.h>
+#include <stdio.h>
+
+#define IDLE_WAIT_MS 1  // Longest sleep between loops while nothing arrives
+
+static PosixTransport transport;
+static bool useNeoPixel = true;
+static int pixelCount = 1;
+static bool trace = false;
+static volatile sig_atomic_t running = 1;
+
+static unsigned long framesShown = 0;
+static unsigned long pinChanges = 0;
+
+LEDController* createLEDController() {
+  if (useNeoPixel) {
+    return new NeoPixelLEDController(12, 11, pixelCount, 128);  // XIAO RP2040 pins
+  }
+  return new DigitalLEDController(LED_BUILTIN);
+}
+
+Transport* createTransport() {
+  return &transport;
+}
+
+static void onShow(const Adafruit_NeoPixel& strip) {
+  framesShown++;
+  if (!trace) return;
+  fprintf(stderr, "%lu.%03lu frame %lu:", millis() / 1000, millis() % 1000, strip.frames());
+  for (uint16_t i = 0; i < strip.numPixels(); i++) {
+    fprintf(stderr, " %06lX", (unsigned long)strip.getPixelColor(i));
+  }
+  fputc('\n', stderr);
+}
+
+static void onPin(int pin, int value) {
+  pinChanges++;
+  if (trace) {
+    fprintf(stderr, "%lu.%03lu pin %d %s\n", millis() / 1000, millis() % 1000, pin, value ? "HIGH" : "LOW");
+  }
+}
+
+static void onSignal(int) {
+  running = 0;
+}
+
+static int usage(const char* name) {
+  fprintf(stderr, "Usage: %s [--stdio] [--led neopixel|digital] [--pixels n] [--corrupt n] [--trace]\n", name);
+  return 2;
+}
+
+int main(int argc, char** argv) {
+  bool stdio = false;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--stdio") == 0) {
+      stdio = true;
+    } else if (strcmp(argv[i], "--led") == 0 && i + 1 < argc) {
+      useNeoPixel = strcmp(argv[++i], "digital") != 0;
+    } else if (strcmp(argv[i], "--pixels") == 0 && i + 1 < argc) {
+      pixelCount = atoi(argv[++i]);
+      if (pixelCount < 1) return usage(argv[0]);
+    } else if (strcmp(argv[i], "--corrupt") == 0 && i + 1 < argc) {
+      int every = atoi(argv[++i]);
+      if (every < 1) return usage(argv[0]);
+      transport.setCorruptEvery((unsigned long)every);
+    } else if (strcmp(argv[i], "--trace") == 0) {
+      trace = true;
+    } else {
+      return usage(argv[0]);
+    }
+  }
+  
+  if (!stdio) {
+    if (!transport.openPty()) {
+      perror("cc-led-sim: cannot create pty");
+      return 1;
+    }
+    printf("%s\n", transport.portPath());
+    fflush(stdout);
+  }
+  
+  signal(SIGINT, onSignal);
+  signal(SIGTERM, onSignal);
+  Adafruit_NeoPixel::showHook = onShow;
+  hostPinHook = onPin;
+  
+  universalSetup();
+  
+  unsigned long loops = 0;
+  while (running) {
+    universalLoop();
+    loops++;
+    
+    if (commandHandler->idle()) {
+      if (transport.inputClosed()) break;
+      transport.waitForInput(IDLE_WAIT_MS);
+    }
+  }
+  
+  fprintf(stderr, "cc-led-sim: %lu loops, %lu frames shown, %lu pin changes in %lu ms\n",
+          loops, framesShown, pinChanges, millis());
+  return 0;
+}
@@ -0,0 +1,17 @@
+#include "AnimationClock.h"
+
+void animationClockStart(AnimationClock* clock, uint32_t now, uint32_t interval) {
+    clock->lastTick = now;
+    clock->interval = interval ? interval : 1;
+    clock->step = 0;
+}
+
+uint32_t animationClockAdvance(AnimationClock* clock, uint32_t now) {
+    uint32_t elapsed = now - clock->lastTick;
+    if (elapsed < clock->interval) return 0;
+
+    uint32_t steps = elapsed / clock->interval;
+    clock->lastTick += steps * clock->interval;
+    clock->step += steps;
+    return steps;
+}
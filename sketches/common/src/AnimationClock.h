@@ -0,0 +1,31 @@
+#ifndef ANIMATION_CLOCK_H
+#define ANIMATION_CLOCK_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Time base for LED animations. The phase is the number of whole intervals
+// since the animation started, derived from millis() rather than counted per
+// update() call, and each tick deadline is advanced by an exact multiple of
+// the interval. A loop stall therefore never adds drift: the next update
+// catches up by as many steps as were missed, and later ticks stay on the
+// original schedule. Times are 32-bit millis() values and may wrap.
+typedef struct {
+    uint32_t lastTick;  // Start time plus step * interval
+    uint32_t interval;  // Milliseconds per step, at least 1
+    uint32_t step;      // Whole intervals since the start
+} AnimationClock;
+
+void animationClockStart(AnimationClock* clock, uint32_t now, uint32_t interval);
+
+// Steps that became due since the last call (0 when none); advances step
+uint32_t animationClockAdvance(AnimationClock* clock, uint32_t now);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ANIMATION_CLOCK_H
@@ -0,0 +1,133 @@
+#ifndef BOARD_CONFIG_H
+#define BOARD_CONFIG_H
+
+#include "RingBuffer.h"
+#include "CommandProcessor.h"
+
+// Per-architecture buffer sizes, chosen at compile time. Any value can be
+// overridden with a -D build flag. Ring sizes must be powers of two.
+
+#ifndef SERIAL_RX_RING_SIZE
+  #if defined(ARDUINO_ARCH_RP2040)
+    #define SERIAL_RX_RING_SIZE 1024  // 264 KB SRAM
+  #elif defined(ARDUINO_ARCH_RENESAS)
+    #define SERIAL_RX_RING_SIZE 256   // UNO R4: 32 KB SRAM
+  #elif defined(ARDUINO_ARCH_AVR)
+    #define SERIAL_RX_RING_SIZE 64    // 2 KB SRAM
+  #else
+    #define SERIAL_RX_RING_SIZE 128
+  #endif
+#endif
+
+// Responses waiting for the UART; drained without blocking from loop().
+// Must hold at least one full response line.
+#ifndef SERIAL_TX_RING_SIZE
+  #if defined(ARDUINO_ARCH_RP2040)
+    #define SERIAL_TX_RING_SIZE 1024
+  #elif defined(ARDUINO_ARCH_RENESAS)
+    #define SERIAL_TX_RING_SIZE 512
+  #elif defined(ARDUINO_ARCH_AVR)
+    #define SERIAL_TX_RING_SIZE 256   // One RESPONSE_MAX_LENGTH line, rounded up
+  #else
+    #define SERIAL_TX_RING_SIZE 256
+  #endif
+#endif
+
+// Decoded commands waiting to run (each entry holds one parsed command)
+#ifndef COMMAND_QUEUE_SIZE
+  #if defined(ARDUINO_ARCH_RP2040)
+    #define COMMAND_QUEUE_SIZE 16
+  #elif defined(ARDUINO_ARCH_RENESAS)
+    #define COMMAND_QUEUE_SIZE 8
+  #elif defined(ARDUINO_ARCH_AVR)
+    #define COMMAND_QUEUE_SIZE 2
+  #else
+    #define COMMAND_QUEUE_SIZE 4
+  #endif
+#endif
+
+// Reliable mode: frames the host may have in flight; each position holds one
+// decoded command received past a gap
+#ifndef RELIABLE_WINDOW
+  #if defined(ARDUINO_ARCH_RP2040)
+    #define RELIABLE_WINDOW 16
+  #elif defined(ARDUINO_ARCH_RENESAS)
+    #define RELIABLE_WINDOW 8
+  #elif defined(ARDUINO_ARCH_AVR)
+    #define RELIABLE_WINDOW 2
+  #else
+    #define RELIABLE_WINDOW 4
+  #endif
+#endif
+
+// Largest payload (decoded bytes) one command may carry, e.g. 3 per PIXELS
+// pixel. Payloads are consumed as they arrive, so this costs no RAM.
+#ifndef PAYLOAD_MAX_BYTES
+  #if defined(ARDUINO_ARCH_RP2040)
+    #define PAYLOAD_MAX_BYTES 4096
+  #elif defined(ARDUINO_ARCH_RENESAS)
+    #define PAYLOAD_MAX_BYTES 2048
+  #elif defined(ARDUINO_ARCH_AVR)
+    #define PAYLOAD_MAX_BYTES 256
+  #else
+    #define PAYLOAD_MAX_BYTES 512
+  #endif
+#endif
+
+// Serial link: rate at power-up, fastest rate BAUD may select, and how long
+// the device stays at a new rate without a valid command before falling back
+#ifndef SERIAL_DEFAULT_BAUD
+  #define SERIAL_DEFAULT_BAUD 9600
+#endif
+
+#ifndef SERIAL_BAUD_MAX
+  #if defined(ARDUINO_ARCH_AVR)
+    #define SERIAL_BAUD_MAX 115200    // 16 MHz UART divider limit
+  #else
+    #define SERIAL_BAUD_MAX 921600
+  #endif
+#endif
+
+// The rates BAUD accepts; keep in step with serial.supportedBaudRates in the
+// board's board.json (the host only proposes those)
+#ifndef SERIAL_BAUD_RATES
+  #if defined(ARDUINO_ARCH_AVR)
+    #define SERIAL_BAUD_RATES 9600, 19200, 38400, 57600, 115200
+  #else
+    #define SERIAL_BAUD_RATES 9600, 19200, 38400, 57600, 115200, 230400, 460800, 921600
+  #endif
+#endif
+
+#ifndef SERIAL_BAUD_CONFIRM_MS
+  #define SERIAL_BAUD_CONFIRM_MS 1000
+#endif
+
+// 1 when the serial port is native USB CDC: while the command queue is full
+// input is left unread and USB flow control holds the host back. A hardware
+// UART cannot push back, so there a command arriving at a full queue is
+// dropped and reported (REJECT,QUEUE,overflow) instead.
+#ifndef SERIAL_RX_BACKPRESSURE
+  #if defined(ARDUINO_ARCH_RP2040) || defined(ARDUINO_ARCH_RENESAS)
+    #define SERIAL_RX_BACKPRESSURE 1
+  #else
+    #define SERIAL_RX_BACKPRESSURE 0
+  #endif
+#endif
+
+// Default number of queued commands run per loop() (setCommandsPerLoop())
+#ifndef COMMANDS_PER_LOOP
+  #define COMMANDS_PER_LOOP 4
+#endif
+
+typedef char serialRxRingSizeCheck[
+    RING_BUFFER_IS_POWER_OF_TWO(SERIAL_RX_RING_SIZE) && SERIAL_RX_RING_SIZE <= 32768 ? 1 : -1];
+typedef char serialTxRingSizeCheck[
+    RING_BUFFER_IS_POWER_OF_TWO(SERIAL_TX_RING_SIZE) && SERIAL_TX_RING_SIZE <= 32768 &&
+    SERIAL_TX_RING_SIZE >= RESPONSE_MAX_LENGTH ? 1 : -1];
+typedef char commandQueueSizeCheck[
+    RING_BUFFER_IS_POWER_OF_TWO(COMMAND_QUEUE_SIZE) && COMMAND_QUEUE_SIZE <= 128 ? 1 : -1];
+typedef char reliableWindowCheck[
+    RING_BUFFER_IS_POWER_OF_TWO(RELIABLE_WINDOW) && RELIABLE_WINDOW <= 128 ? 1 : -1];
+typedef char payloadMaxBytesCheck[PAYLOAD_MAX_BYTES > 0 && PAYLOAD_MAX_BYTES <= 65535 ? 1 : -1];
+
+#endif // BOARD_CONFIG_H
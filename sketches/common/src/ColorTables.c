@@ -0,0 +1,74 @@
+#include "ColorTables.h"
+
+#if defined(__AVR__)
+  #include <avr/pgmspace.h>
+  #define TABLE_READ(address) pgm_read_byte(address)
+#else
+  // Other cores keep const data in flash without special access
+  #ifndef PROGMEM
+    #define PROGMEM
+  #endif
+  #define TABLE_READ(address) (*(address))
+#endif
+
+// round(255 * (i / 255)^2.6), as in the Adafruit_NeoPixel gamma table
+static const uint8_t GAMMA_TABLE[256] PROGMEM = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+      0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,   1,   1,   1,   1,
+      1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,   2,   3,   3,   3,   3,
+      3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   5,   6,   6,   6,   6,   7,
+      7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  10,  11,  11,  11,  12,  12,
+     13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,  20,
+     20,  21,  21,  22,  22,  23,  24,  24,  25,  25,  26,  27,  27,  28,  29,  29,
+     30,  31,  31,  32,  33,  34,  34,  35,  36,  37,  38,  38,  39,  40,  41,  42,
+     42,  43,  44,  45,  46,  47,  48,  49,  50,  51,  52,  53,  54,  55,  56,  57,
+     58,  59,  60,  61,  62,  63,  64,  65,  66,  68,  69,  70,  71,  72,  73,  75,
+     76,  77,  78,  80,  81,  82,  84,  85,  86,  88,  89,  90,  92,  93,  94,  96,
+     97,  99, 100, 102, 103, 105, 106, 108, 109, 111, 112, 114, 115, 117, 119, 120,
+    122, 124, 125, 127, 129, 130, 132, 134, 136, 137, 139, 141, 143, 145, 146, 148,
+    150, 152, 154, 156, 158, 160, 162, 164, 166, 168, 170, 172, 174, 176, 178, 180,
+    182, 184, 186, 188, 191, 193, 195, 197, 199, 202, 204, 206, 209, 211, 213, 215,
+    218, 220, 223, 225, 227, 230, 232, 235, 237, 240, 242, 245, 247, 250, 252, 255,
+};
+
+// Hue wheel entry i is ColorHSV(i << 8): the hue maps onto six 255-step
+// segments (0-1530) and each channel ramps up, holds or ramps down
+#define WHEEL_POSITION(i) (((uint32_t)(i) * 256UL * 1530UL + 32768UL) / 65536UL)
+#define WHEEL_R(h) ((h) < 255 ? 255 : (h) < 510 ? 510 - (h) : (h) < 1020 ? 0 : (h) < 1275 ? (h) - 1020 : 255)
+#define WHEEL_G(h) ((h) < 255 ? (h) : (h) < 765 ? 255 : (h) < 1020 ? 1020 - (h) : 0)
+#define WHEEL_B(h) ((h) < 510 ? 0 : (h) < 765 ? (h) - 510 : (h) < 1275 ? 255 : (h) < 1530 ? 1530 - (h) : 0)
+#define WHEEL_ENTRY(i) { WHEEL_R(WHEEL_POSITION(i)), WHEEL_G(WHEEL_POSITION(i)), WHEEL_B(WHEEL_POSITION(i)) }
+#define WHEEL_ROW4(i)  WHEEL_ENTRY(i), WHEEL_ENTRY((i) + 1), WHEEL_ENTRY((i) + 2), WHEEL_ENTRY((i) + 3)
+#define WHEEL_ROW16(i) WHEEL_ROW4(i), WHEEL_ROW4((i) + 4), WHEEL_ROW4((i) + 8), WHEEL_ROW4((i) + 12)
+#define WHEEL_ROW64(i) WHEEL_ROW16(i), WHEEL_ROW16((i) + 16), WHEEL_ROW16((i) + 32), WHEEL_ROW16((i) + 48)
+
+static const uint8_t HUE_TABLE[256][3] PROGMEM = {
+    WHEEL_ROW64(0), WHEEL_ROW64(64), WHEEL_ROW64(128), WHEEL_ROW64(192)
+};
+
+uint8_t colorGamma8(uint8_t value) {
+    return TABLE_READ(&GAMMA_TABLE[value]);
+}
+
+void colorHue(uint16_t hue, uint8_t* r, uint8_t* g, uint8_t* b) {
+    const uint8_t* rgb = HUE_TABLE[(uint8_t)((hue + 128) >> 8)];
+    *r = TABLE_READ(&GAMMA_TABLE[TABLE_READ(&rgb[0])]);
+    *g = TABLE_READ(&GAMMA_TABLE[TABLE_READ(&rgb[1])]);
+    *b = TABLE_READ(&GAMMA_TABLE[TABLE_READ(&rgb[2])]);
+}
+
+void colorRainbowFill(FrameBuffer* fb, uint16_t baseHue) {
+    if (fb->count == 0) return;
+
+    // Hue as a 32-bit turn fraction: the top 8 bits pick the wheel entry
+    // (rounded to nearest), so each pixel is one add and six table reads
+    uint32_t hue = ((uint32_t)baseHue << 16) + 0x800000UL;
+    uint32_t step = 0xFFFFFFFFUL / fb->count + 1;
+    for (uint16_t i = 0; i < fb->count; i++, hue += step) {
+        const uint8_t* rgb = HUE_TABLE[hue >> 24];
+        frameBufferSet(fb, i,
+                       TABLE_READ(&GAMMA_TABLE[TABLE_READ(&rgb[0])]),
+                       TABLE_READ(&GAMMA_TABLE[TABLE_READ(&rgb[1])]),
+                       TABLE_READ(&GAMMA_TABLE[TABLE_READ(&rgb[2])]));
+    }
+}
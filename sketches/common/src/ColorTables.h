@@ -0,0 +1,30 @@
+#ifndef COLOR_TABLES_H
+#define COLOR_TABLES_H
+
+#include "FrameBuffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Table-driven color kernels for animations. A 256-entry hue wheel (the
+// Adafruit ColorHSV() wheel at full saturation and value, generated by the
+// compiler) and a 256-entry gamma table (gamma 2.6, the same curve as
+// Adafruit gamma8()) live in flash, so a rainbow pixel costs a few table
+// reads instead of a ColorHSV() and gamma32() call. Hues are rounded to the
+// nearest of 256 wheel positions.
+
+// Gamma-corrected channel value, identical to Adafruit_NeoPixel::gamma8()
+uint8_t colorGamma8(uint8_t value);
+
+// Gamma-corrected rainbow color for a 16-bit hue (0 = red, 65536 = one turn)
+void colorHue(uint16_t hue, uint8_t* r, uint8_t* g, uint8_t* b);
+
+// One full hue turn spread along the strip, pixel 0 at baseHue
+void colorRainbowFill(FrameBuffer* fb, uint16_t baseHue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COLOR_TABLES_H
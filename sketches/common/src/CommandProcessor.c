@@ -1,234 +1,863 @@
 #include "CommandProcessor.h"
-#include <stdio.h>
+#include "FrameCodec.h"
+#include "BoardConfig.h"
 #include <string.h>
-#include <stdlib.h>
+#include <limits.h>
 
-bool parseColorCommand(const char* cmd, uint8_t* r, uint8_t* g, uint8_t* b) {
-    if (!cmd || strncmp(cmd, "COLOR,", 6) != 0) {
-        return false;
+bool decimalAccumulate(long* value, char digit) {
+    if (digit < '0' || digit > '9') return false;
+
+    int d = digit - '0';
+    if (*value > (LONG_MAX - d) / 10) return false;
+
+    *value = *value * 10 + d;
+    return true;
+}
+
+uint8_t formatUnsigned(unsigned long value, char* out) {
+    char digits[DECIMAL_MAX_CHARS];
+    uint8_t count = 0;
+    uint8_t length = 0;
+
+    do {
+        digits[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    while (count > 0) out[length++] = digits[--count];
+    return length;
+}
+
+uint8_t formatDecimal(long value, char* out) {
+    if (value >= 0) return formatUnsigned((unsigned long)value, out);
+
+    // Work on the unsigned magnitude so LONG_MIN does not overflow
+    out[0] = '-';
+    return (uint8_t)(1 + formatUnsigned(0UL - (unsigned long)value, out + 1));
+}
+
+void responseWriterInit(ResponseWriter* writer, char* buffer, uint16_t size) {
+    writer->buffer = buffer;
+    writer->capacity = size - RESPONSE_RESERVED_BYTES;
+    writer->length = 0;
+    writer->overflow = false;
+    buffer[0] = '\0';
+}
+
+void responseAppendVerb(ResponseWriter* writer, const char* verb, uint8_t length) {
+    if (!verb) return;
+
+    for (uint8_t i = 0; i < length && verb[i] != '\0'; i++) {
+        if (writer->length >= writer->capacity) {
+            writer->overflow = true;
+            break;
+        }
+        writer->buffer[writer->length++] = verb[i];
     }
-    
-    const char* params = cmd + 6; // Skip "COLOR,"
-    
-    // Find comma positions
-    const char* comma1 = strchr(params, ',');
-    if (!comma1) return false;
-    
-    const char* comma2 = strchr(comma1 + 1, ',');
-    if (!comma2) return false;
-    
-    // Check for extra parameters
-    if (strchr(comma2 + 1, ',') != NULL) return false;
-    
-    // Parse RGB values
-    int r_val = atoi(params);
-    int g_val = atoi(comma1 + 1);
-    int b_val = atoi(comma2 + 1);
-    
-    // Validate bounds (0-255) and negative detection
-    if (r_val < 0 || r_val > 255 || g_val < 0 || g_val > 255 || b_val < 0 || b_val > 255) {
-        return false;
+    writer->buffer[writer->length] = '\0';
+}
+
+void responseAppendLiteral(ResponseWriter* writer, const char* text) {
+    responseAppendVerb(writer, text, UINT8_MAX);
+}
+
+void responseAppendInt(ResponseWriter* writer, long value) {
+    char digits[DECIMAL_MAX_CHARS];
+    responseAppendVerb(writer, digits, formatDecimal(value, digits));
+}
+
+void responseAppendUnsigned(ResponseWriter* writer, unsigned long value) {
+    char digits[DECIMAL_MAX_CHARS];
+    responseAppendVerb(writer, digits, formatUnsigned(value, digits));
+}
+
+void responseEndLine(ResponseWriter* writer) {
+    // Always fits: the line end was reserved at init
+    writer->buffer[writer->length++] = '\r';
+    writer->buffer[writer->length++] = '\n';
+    writer->buffer[writer->length] = '\0';
+}
+
+// Argument ranges shared by the command table
+#define RANGE_BYTE     { 0, 255 }
+#define RANGE_INTERVAL { 1, LONG_MAX }
+
+static const ArgRange RGB_RANGES[] = { RANGE_BYTE, RANGE_BYTE, RANGE_BYTE };
+static const ArgRange BLINK1_RANGES[] = { RANGE_BYTE, RANGE_BYTE, RANGE_BYTE, RANGE_INTERVAL };
+static const ArgRange BLINK2_RANGES[] = {
+    RANGE_BYTE, RANGE_BYTE, RANGE_BYTE, RANGE_BYTE, RANGE_BYTE, RANGE_BYTE, RANGE_INTERVAL
+};
+static const ArgRange INTERVAL_RANGES[] = { RANGE_INTERVAL };
+static const ArgRange FLAG_RANGES[] = { { 0, 1 } };
+static const ArgRange BAUD_RANGES[] = { { 1200, SERIAL_BAUD_MAX } };  // Then SERIAL_BAUD_RATES only
+static const ArgRange PIXEL_RANGES[] = { { 0, 65535 } };  // First pixel index
+static const ArgRange FILL_RANGES[] = { { 0, 65535 }, { 1, 65535 }, RANGE_BYTE, RANGE_BYTE, RANGE_BYTE };
+static const ArgRange FADE_RANGES[] = {  // Duration in ms, easing curve (EaseCurve in Transition.h)
+    RANGE_BYTE, RANGE_BYTE, RANGE_BYTE, { 0, 65535 }, { 0, 3 }
+};
+
+// Built-in command table, ordered by opcode (row i describes opcode i + 1).
+// Adding a verb: append a row here, add its opcode, and handle it in
+// SerialCommandHandler::executeCommand().
+static const CommandSpec commandTable[] = {
+    { "ON",       2, OPCODE_ON,       0, NULL,            NULL,        "invalid parameters", 0 },
+    { "OFF",      3, OPCODE_OFF,      0, NULL,            NULL,        "invalid parameters", 0 },
+    { "COLOR",    5, OPCODE_COLOR,    3, RGB_RANGES,      NULL,        "invalid format",     0 },
+    { "BLINK1",   6, OPCODE_BLINK1,   4, BLINK1_RANGES,   "interval=", "invalid parameters", 0 },
+    { "BLINK2",   6, OPCODE_BLINK2,   7, BLINK2_RANGES,   "interval=", "invalid parameters", 0 },
+    { "RAINBOW",  7, OPCODE_RAINBOW,  1, INTERVAL_RANGES, "interval=", "invalid interval",   0 },
+    { "ECHO",     4, OPCODE_ECHO,     1, FLAG_RANGES,     NULL,        "invalid parameters", 0 },
+    { "QUIET",    5, OPCODE_QUIET,    1, FLAG_RANGES,     NULL,        "invalid parameters", 0 },
+    { "STATS",    5, OPCODE_STATS,    0, NULL,            NULL,        "invalid parameters", 0 },
+    { "BAUD",     4, OPCODE_BAUD,     1, BAUD_RANGES,     NULL,        "unsupported rate",   0 },
+    { "PING",     4, OPCODE_PING,     0, NULL,            NULL,        "invalid parameters", 0 },
+    { "FLOW",     4, OPCODE_FLOW,     1, FLAG_RANGES,     NULL,        "invalid parameters", 0 },
+    { "PIXELS",   6, OPCODE_PIXELS,   1, PIXEL_RANGES,    "count=",    "invalid parameters", 3 },
+    { "RELIABLE", 8, OPCODE_RELIABLE, 1, FLAG_RANGES,     NULL,        "invalid parameters", 0 },
+    { "CAPS",     4, OPCODE_CAPS,     0, NULL,            NULL,        "invalid parameters", 0 },
+    { "FILL",     4, OPCODE_FILL,     5, FILL_RANGES,     NULL,        "invalid parameters", 0 },
+    { "FADE",     4, OPCODE_FADE,     5, FADE_RANGES,     NULL,        "invalid parameters", 0 },
+};
+
+#define COMMAND_TABLE_SIZE (sizeof(commandTable) / sizeof(commandTable[0]))
+
+// A verb added past the registry's capacity needs more COMMAND_REGISTRY_SLOTS
+typedef char commandTableSizeCheck[COMMAND_TABLE_SIZE <= COMMAND_REGISTRY_CAPACITY ? 1 : -1];
+
+static CommandRegistry defaultRegistry;
+static bool defaultRegistryReady = false;
+
+static uint8_t hashVerb(const char* verb, uint8_t length) {
+    uint8_t hash = length;
+    for (uint8_t i = 0; i < length; i++) {
+        hash = (uint8_t)((hash * 33) ^ (uint8_t)verb[i]);
+    }
+    return hash & (COMMAND_REGISTRY_SLOTS - 1);
+}
+
+bool commandRegistryInit(CommandRegistry* registry, const CommandSpec* specs, uint8_t count) {
+    if (!registry) return false;
+
+    registry->specs = specs;
+    registry->count = 0;
+    memset(registry->slots, 0, sizeof(registry->slots));
+    if (count > COMMAND_REGISTRY_CAPACITY) return false;
+
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t slot = hashVerb(specs[i].verb, specs[i].verbLength);
+        while (registry->slots[slot] != 0) {
+            slot = (slot + 1) & (COMMAND_REGISTRY_SLOTS - 1);  // Linear probing
+        }
+        registry->slots[slot] = i + 1;
+        registry->count++;
+    }
+    return true;
+}
+
+const CommandSpec* commandRegistryFind(const CommandRegistry* registry, const char* verb, uint8_t length) {
+    if (!registry || !verb || length == 0) return NULL;
+
+    uint8_t slot = hashVerb(verb, length);
+    while (registry->slots[slot] != 0) {
+        const CommandSpec* spec = &registry->specs[registry->slots[slot] - 1];
+        if (spec->verbLength == length && memcmp(spec->verb, verb, length) == 0) {
+            return spec;
+        }
+        slot = (slot + 1) & (COMMAND_REGISTRY_SLOTS - 1);
+    }
+
+    return NULL;
+}
+
+const CommandSpec* findCommandSpec(const char* verb, uint8_t length) {
+    if (!defaultRegistryReady) {
+        commandRegistryInit(&defaultRegistry, commandTable, COMMAND_TABLE_SIZE);
+        defaultRegistryReady = true;
+    }
+    return commandRegistryFind(&defaultRegistry, verb, length);
+}
+
+const CommandSpec* commandSpecForOpcode(CommandOpcode opcode) {
+    if (opcode == OPCODE_NONE || (size_t)opcode > COMMAND_TABLE_SIZE) return NULL;
+    return &commandTable[opcode - 1];
+}
+
+static bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+static bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+static int hexValue(char c) {
+    if (isDigit(c)) return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+// Arguments a complete command carries: a payload adds its unit count
+static uint8_t specArgCount(const CommandSpec* spec) {
+    return spec->arity + (spec->payloadUnit > 0 ? 1 : 0);
+}
+
+// Start the next item; batch accounting carries over within a line
+static void streamResetItem(CommandStream* stream) {
+    stream->state = STREAM_IDLE;
+    stream->verb[0] = '\0';
+    stream->verbLength = 0;
+    stream->verbOverflow = false;
+    stream->negative = false;
+    stream->value = 0;
+    stream->spec = NULL;
+    stream->command.opcode = OPCODE_NONE;
+    stream->command.error = PARSE_UNKNOWN_COMMAND;
+    stream->command.argCount = 0;
+    stream->unitLength = 0;
+    stream->highNibble = true;
+    stream->unitCount = 0;
+    stream->payloadBytes = 0;
+    stream->unitReady = false;
+}
+
+void commandStreamReset(CommandStream* stream) {
+    if (!stream) return;
+
+    streamResetItem(stream);
+    stream->command.tagged = false;  // A tag covers its whole line
+    stream->command.tag = 0;
+    stream->batch.count = 0;
+    stream->batch.rejected = 0;
+    stream->batch.overflow = false;
+    stream->lineComplete = false;
+}
+
+bool commandStreamInBatch(const CommandStream* stream) {
+    return stream->batch.count > 1 || !stream->lineComplete;
+}
+
+// Record the first error of the item and skip to its newline
+static void streamFail(CommandStream* stream, ParseError error) {
+    if (error == PARSE_UNKNOWN_COMMAND) {
+        stream->command.opcode = OPCODE_NONE;
+    }
+    stream->command.error = error;
+    stream->state = STREAM_DISCARD;
+}
+
+// A malformed tag is not echoed back
+static void streamFailTag(CommandStream* stream) {
+    stream->command.tagged = false;
+    streamFail(stream, PARSE_UNKNOWN_COMMAND);
+}
+
+// Verb finished: look it up once; withArgs tells whether a comma ended it
+static void streamEndVerb(CommandStream* stream, bool withArgs) {
+    stream->verb[stream->verbLength] = '\0';
+
+    const CommandSpec* spec = stream->verbOverflow
+        ? NULL
+        : findCommandSpec(stream->verb, stream->verbLength);
+    if (!spec || withArgs != (spec->arity > 0)) {
+        streamFail(stream, PARSE_UNKNOWN_COMMAND);
+        return;
+    }
+
+    stream->spec = spec;
+    stream->command.opcode = spec->opcode;
+    stream->state = withArgs ? STREAM_ARG_START : STREAM_TRAILING;
+}
+
+static const long SUPPORTED_BAUD_RATES[] = { SERIAL_BAUD_RATES };
+
+// Range check shared by text and binary arguments; a BAUD rate must also be
+// one the board supports, not just any value up to SERIAL_BAUD_MAX
+static bool argumentAllowed(const CommandSpec* spec, uint8_t index, long value) {
+    const ArgRange* range = &spec->ranges[index];
+    if (value < range->min || value > range->max) return false;
+    if (spec->opcode != OPCODE_BAUD) return true;
+
+    for (size_t i = 0; i < sizeof(SUPPORTED_BAUD_RATES) / sizeof(SUPPORTED_BAUD_RATES[0]); i++) {
+        if (SUPPORTED_BAUD_RATES[i] == value) return true;
+    }
+    return false;
+}
+
+// Argument finished: range-check it against the spec and store it
+static bool streamEndArg(CommandStream* stream) {
+    uint8_t index = stream->command.argCount;
+    if (index >= stream->spec->arity) return false;  // Extra parameters
+
+    // A sign is only valid where the range has negative values ("-0" is not 0)
+    if (stream->negative && stream->spec->ranges[index].min >= 0) return false;
+
+    long value = stream->negative ? -stream->value : stream->value;
+    if (!argumentAllowed(stream->spec, index, value)) return false;
+
+    stream->command.args[index] = value;
+    stream->command.argCount++;
+    stream->negative = false;
+    stream->value = 0;
+    return true;
+}
+
+// One hex digit of payload; every payloadUnit bytes complete a unit
+static void streamPayloadNibble(CommandStream* stream, uint8_t nibble) {
+    if (stream->highNibble) {
+        if (stream->payloadBytes >= PAYLOAD_MAX_BYTES) {
+            streamFail(stream, PARSE_PAYLOAD_TOO_LONG);
+            return;
+        }
+        stream->unit[stream->unitLength] = (uint8_t)(nibble << 4);
+        stream->highNibble = false;
+        return;
+    }
+
+    stream->unit[stream->unitLength++] |= nibble;
+    stream->payloadBytes++;
+    stream->highNibble = true;
+    if (stream->unitLength == stream->spec->payloadUnit) {
+        stream->unitLength = 0;
+        stream->unitCount++;
+        stream->unitReady = true;
+    }
+}
+
+// Payload finished: whole units only, at least one; the count becomes the last argument
+static bool streamEndPayload(CommandStream* stream) {
+    if (stream->unitCount == 0 || stream->unitLength != 0 || !stream->highNibble) return false;
+
+    stream->command.args[stream->command.argCount++] = stream->unitCount;
+    return true;
+}
+
+static bool streamEndItem(CommandStream* stream, bool lineEnd) {
+    switch (stream->state) {
+        case STREAM_IDLE:
+            if (lineEnd && stream->batch.count == 0 && !stream->command.tagged) {
+                return false;  // Blank line
+            }
+            streamFail(stream, PARSE_UNKNOWN_COMMAND);  // Empty batch item
+            break;
+        case STREAM_TAG:
+            streamFailTag(stream);  // Line ended inside the tag
+            break;
+        case STREAM_VERB:
+            streamEndVerb(stream, false);
+            break;
+        case STREAM_ARG_START:
+            streamFail(stream, PARSE_INVALID_ARGS);  // Trailing comma or lone sign
+            break;
+        case STREAM_ARG_DIGITS:
+            if (!streamEndArg(stream)) streamFail(stream, PARSE_INVALID_ARGS);
+            break;
+        case STREAM_PAYLOAD:
+            if (!streamEndPayload(stream)) streamFail(stream, PARSE_INVALID_ARGS);
+            break;
+        default:
+            break;
+    }
+
+    if (stream->state != STREAM_DISCARD) {
+        stream->command.error = (stream->command.argCount == specArgCount(stream->spec))
+            ? PARSE_OK
+            : PARSE_INVALID_ARGS;
+    }
+
+    if (stream->batch.count < COMMAND_BATCH_MAX) {
+        if (stream->command.error != PARSE_OK) {
+            stream->batch.rejected |= 1UL << stream->batch.count;
+        }
+        stream->batch.count++;
+    } else {
+        stream->batch.overflow = true;
+        stream->command.error = PARSE_INVALID_ARGS;  // Not run
+    }
+
+    stream->lineComplete = lineEnd;
+    stream->state = STREAM_COMPLETE;
+    return true;
+}
+
+bool commandStreamFeed(CommandStream* stream, char c) {
+    if (!stream) return false;
+
+    stream->unitReady = false;
+    if (stream->state == STREAM_COMPLETE) {
+        if (stream->lineComplete) {
+            commandStreamReset(stream);
+        } else {
+            streamResetItem(stream);
+        }
+    }
+
+    if (c == '\n' || c == COMMAND_SEPARATOR) {
+        return streamEndItem(stream, c == '\n');
+    }
+
+    switch (stream->state) {
+        case STREAM_IDLE:
+            if (isBlank(c)) break;
+            if (c == '#' && stream->batch.count == 0 && !stream->command.tagged) {
+                stream->command.tagged = true;
+                stream->value = -1;  // No digits yet
+                stream->state = STREAM_TAG;
+                break;
+            }
+            stream->state = STREAM_VERB;
+            /* fall through */
+        case STREAM_VERB:
+            if (c == ',') {
+                streamEndVerb(stream, true);
+            } else if (isBlank(c)) {
+                streamEndVerb(stream, false);
+            } else if (stream->verbLength < COMMAND_VERB_MAX) {
+                stream->verb[stream->verbLength++] = c;
+            } else {
+                stream->verbOverflow = true;
+            }
+            break;
+
+        case STREAM_TAG: {
+            long next = (stream->value < 0 ? 0 : stream->value * 10) + (c - '0');
+            if (isDigit(c) && next <= SEQUENCE_TAG_MAX) {
+                stream->value = next;
+            } else if (c == ',' && stream->value >= 0) {
+                stream->command.tag = (uint16_t)stream->value;
+                stream->value = 0;
+                stream->state = STREAM_IDLE;
+            } else {
+                streamFailTag(stream);
+            }
+            break;
+        }
+
+        case STREAM_ARG_START:
+            if (c == '-' && !stream->negative) {
+                stream->negative = true;
+                break;
+            }
+            if (!isDigit(c)) {
+                streamFail(stream, PARSE_INVALID_ARGS);
+                break;
+            }
+            stream->state = STREAM_ARG_DIGITS;
+            /* fall through */
+        case STREAM_ARG_DIGITS:
+            if (isDigit(c)) {
+                if (!decimalAccumulate(&stream->value, c)) {
+                    streamFail(stream, PARSE_INVALID_ARGS);  // Overflow
+                }
+            } else if (c == ',' && streamEndArg(stream)) {
+                if (stream->command.argCount < stream->spec->arity) {
+                    stream->state = STREAM_ARG_START;
+                } else if (stream->spec->payloadUnit > 0) {
+                    stream->state = STREAM_PAYLOAD;
+                } else {
+                    streamFail(stream, PARSE_INVALID_ARGS);  // Extra parameters
+                }
+            } else if (isBlank(c) && streamEndArg(stream)) {
+                stream->state = STREAM_TRAILING;
+            } else {
+                streamFail(stream, PARSE_INVALID_ARGS);
+            }
+            break;
+
+        case STREAM_PAYLOAD: {
+            int nibble = hexValue(c);
+            if (nibble >= 0) {
+                streamPayloadNibble(stream, (uint8_t)nibble);
+            } else if (isBlank(c) && streamEndPayload(stream)) {
+                stream->state = STREAM_TRAILING;
+            } else {
+                streamFail(stream, PARSE_INVALID_ARGS);
+            }
+            break;
+        }
+
+        case STREAM_TRAILING:
+            if (!isBlank(c)) {
+                streamFail(stream, stream->command.argCount > 0 ? PARSE_INVALID_ARGS : PARSE_UNKNOWN_COMMAND);
+            }
+            break;
+
+        default:  // STREAM_DISCARD
+            break;
+    }
+
+    return false;
+}
+
+bool parseCommand(const char* cmd, ParsedCommand* parsed) {
+    if (!parsed) return false;
+
+    CommandStream stream;
+    commandStreamReset(&stream);
+
+    if (cmd) {
+        while (*cmd != '\0' && *cmd != '\n' && *cmd != COMMAND_SEPARATOR) {
+            commandStreamFeed(&stream, *cmd++);
+        }
     }
-    
-    // Additional check for negative strings (atoi returns 0 for invalid input)
-    if ((r_val == 0 && params[0] == '-') ||
-        (g_val == 0 && (comma1 + 1)[0] == '-') ||
-        (b_val == 0 && (comma2 + 1)[0] == '-')) {
+
+    if (!commandStreamFeed(&stream, '\n')) {
+        commandStreamReset(&stream);  // Blank line: unknown command
+    }
+
+    *parsed = stream.command;
+    return parsed->error == PARSE_OK;
+}
+
+uint8_t commandArgWidth(const ArgRange* range) {
+    if (range->max <= 0xFF) return 1;
+    if (range->max <= 0xFFFF) return 2;
+    return 4;
+}
+
+// CRC-checked frame payload: false (PARSE_BAD_FRAME) unless at least
+// minLength bytes precede a matching CRC
+static bool frameIntact(const uint8_t* payload, uint8_t length, uint8_t minLength, bool lengthSeeded,
+                        ParsedCommand* parsed) {
+    parsed->opcode = OPCODE_NONE;
+    parsed->error = PARSE_BAD_FRAME;
+    parsed->argCount = 0;
+    parsed->tagged = false;
+
+    if (!payload || length <= minLength) return false;
+
+    uint8_t seed = lengthSeeded ? (uint8_t)(length - 1) : 0;
+    return crc8Seeded(seed, payload, length - 1) == payload[length - 1];
+}
+
+// Opcode and arguments of a frame body (CRC already checked and excluded)
+static bool decodeFrameBody(const uint8_t* payload, uint8_t length, ParsedCommand* parsed) {
+    // Payload verbs are text-only: a frame is too short to carry one
+    const CommandSpec* spec = commandSpecForOpcode((CommandOpcode)payload[0]);
+    if (!spec || spec->payloadUnit > 0) {
+        parsed->error = PARSE_UNKNOWN_COMMAND;
         return false;
     }
-    
-    *r = (uint8_t)r_val;
-    *g = (uint8_t)g_val;
-    *b = (uint8_t)b_val;
-    
+
+    parsed->opcode = spec->opcode;
+    parsed->error = PARSE_INVALID_ARGS;
+
+    uint8_t offset = 1;
+    uint8_t argsEnd = length;
+    for (uint8_t i = 0; i < spec->arity; i++) {
+        const ArgRange* range = &spec->ranges[i];
+        uint8_t width = commandArgWidth(range);
+        if (offset + width > argsEnd) return false;
+
+        unsigned long value = 0;
+        for (uint8_t b = 0; b < width; b++) {
+            value |= (unsigned long)payload[offset + b] << (8 * b);
+        }
+        offset += width;
+
+        // Binary arguments are unsigned; compare before narrowing to long
+        if (value > (unsigned long)range->max || !argumentAllowed(spec, i, (long)value)) return false;
+        parsed->args[parsed->argCount++] = (long)value;
+    }
+
+    if (offset != argsEnd) return false;  // Extra bytes
+
+    parsed->error = PARSE_OK;
     return true;
 }
 
-bool parseBlink1Command(const char* cmd, uint8_t* r, uint8_t* g, uint8_t* b, long* interval) {
-    if (!cmd || strncmp(cmd, "BLINK1,", 7) != 0) {
+bool decodeCommandFrame(const uint8_t* payload, uint8_t length, ParsedCommand* parsed) {
+    if (!parsed || !frameIntact(payload, length, 1, false, parsed)) return false;
+    return decodeFrameBody(payload, length - 1, parsed);
+}
+
+bool decodeReliableFrame(const uint8_t* payload, uint8_t length, uint8_t* sequence, ParsedCommand* parsed) {
+    if (!parsed || !frameIntact(payload, length, 2, true, parsed)) return false;
+
+    *sequence = payload[0];
+    return decodeFrameBody(payload + 1, length - 2, parsed);
+}
+
+uint8_t encodeResponseFrame(const ParsedCommand* parsed, uint8_t* out) {
+    uint8_t payload[RESPONSE_FRAME_PAYLOAD];
+    payload[0] = (uint8_t)parsed->opcode;
+    payload[1] = (uint8_t)parsed->error;
+    payload[2] = crc8(payload, 2);
+    return frameEncode(payload, sizeof(payload), out);
+}
+
+uint8_t encodeReliableResponseFrame(uint8_t sequence, const ParsedCommand* parsed, uint8_t* out) {
+    uint8_t payload[RELIABLE_RESPONSE_PAYLOAD];
+    payload[0] = sequence;
+    payload[1] = (uint8_t)parsed->opcode;
+    payload[2] = (uint8_t)parsed->error;
+    payload[3] = crc8Seeded(3, payload, 3);
+    return frameEncode(payload, sizeof(payload), out);
+}
+
+bool parseColorCommand(const char* cmd, uint8_t* r, uint8_t* g, uint8_t* b) {
+    ParsedCommand parsed;
+    if (!parseCommand(cmd, &parsed) || parsed.opcode != OPCODE_COLOR) {
         return false;
     }
-    
-    const char* params = cmd + 7; // Skip "BLINK1,"
-    
-    // Find comma positions
-    const char* comma1 = strchr(params, ',');
-    if (!comma1) return false;
-    
-    const char* comma2 = strchr(comma1 + 1, ',');
-    if (!comma2) return false;
-    
-    const char* comma3 = strchr(comma2 + 1, ',');
-    if (!comma3) return false;
-    
-    // Check for extra parameters
-    if (strchr(comma3 + 1, ',') != NULL) return false;
-    
-    // Parse values
-    int r_val = atoi(params);
-    int g_val = atoi(comma1 + 1);
-    int b_val = atoi(comma2 + 1);
-    long interval_val = atol(comma3 + 1);
-    
-    // Validate RGB bounds and interval > 0
-    if (r_val < 0 || r_val > 255 || g_val < 0 || g_val > 255 || 
-        b_val < 0 || b_val > 255 || interval_val <= 0) {
+
+    *r = (uint8_t)parsed.args[0];
+    *g = (uint8_t)parsed.args[1];
+    *b = (uint8_t)parsed.args[2];
+
+    return true;
+}
+
+bool parseBlink1Command(const char* cmd, uint8_t* r, uint8_t* g, uint8_t* b, long* interval) {
+    ParsedCommand parsed;
+    if (!parseCommand(cmd, &parsed) || parsed.opcode != OPCODE_BLINK1) {
         return false;
     }
-    
-    *r = (uint8_t)r_val;
-    *g = (uint8_t)g_val;
-    *b = (uint8_t)b_val;
-    *interval = interval_val;
-    
+
+    *r = (uint8_t)parsed.args[0];
+    *g = (uint8_t)parsed.args[1];
+    *b = (uint8_t)parsed.args[2];
+    *interval = parsed.args[3];
+
     return true;
 }
 
 bool parseBlink2Command(const char* cmd, uint8_t* r1, uint8_t* g1, uint8_t* b1,
                        uint8_t* r2, uint8_t* g2, uint8_t* b2, long* interval) {
-    if (!cmd || strncmp(cmd, "BLINK2,", 7) != 0) {
+    ParsedCommand parsed;
+    if (!parseCommand(cmd, &parsed) || parsed.opcode != OPCODE_BLINK2) {
         return false;
     }
-    
-    int temp_r1, temp_g1, temp_b1, temp_r2, temp_g2, temp_b2, temp_interval;
-    int result = sscanf(cmd, "BLINK2,%d,%d,%d,%d,%d,%d,%d", 
-                       &temp_r1, &temp_g1, &temp_b1, &temp_r2, &temp_g2, &temp_b2, &temp_interval);
-    
-    if (result == 7 && temp_interval > 0 && 
-        temp_r1 >= 0 && temp_r1 <= 255 && temp_g1 >= 0 && temp_g1 <= 255 && temp_b1 >= 0 && temp_b1 <= 255 &&
-        temp_r2 >= 0 && temp_r2 <= 255 && temp_g2 >= 0 && temp_g2 <= 255 && temp_b2 >= 0 && temp_b2 <= 255) {
-        *r1 = (uint8_t)temp_r1;
-        *g1 = (uint8_t)temp_g1;
-        *b1 = (uint8_t)temp_b1;
-        *r2 = (uint8_t)temp_r2;
-        *g2 = (uint8_t)temp_g2;
-        *b2 = (uint8_t)temp_b2;
-        *interval = temp_interval;
-        return true;
-    }
-    
-    return false;
+
+    *r1 = (uint8_t)parsed.args[0];
+    *g1 = (uint8_t)parsed.args[1];
+    *b1 = (uint8_t)parsed.args[2];
+    *r2 = (uint8_t)parsed.args[3];
+    *g2 = (uint8_t)parsed.args[4];
+    *b2 = (uint8_t)parsed.args[5];
+    *interval = parsed.args[6];
+
+    return true;
 }
 
 bool parseRainbowCommand(const char* cmd, long* interval) {
-    if (!cmd) return false;
-    
-    int temp_interval;
-    int result = sscanf(cmd, "RAINBOW,%d", &temp_interval);
-    
-    if (result == 1 && temp_interval > 0) {
-        *interval = temp_interval;
-        return true;
-    }
-    
-    return false;
+    ParsedCommand parsed;
+    if (!parseCommand(cmd, &parsed) || parsed.opcode != OPCODE_RAINBOW) {
+        return false;
+    }
+
+    *interval = parsed.args[0];
+
+    return true;
 }
 
-void processCommand(const char* cmd, CommandResponse* response) {
-    if (!cmd || !response) {
-        if (response) {
-            response->result = COMMAND_REJECTED;
-            strcpy(response->response, "REJECT,,unknown command");
-        }
-        return;
+// ACCEPTED|REJECT, followed by the sequence tag when the command carried one
+static void writeStatus(ResponseWriter* writer, bool accepted, const ParsedCommand* parsed) {
+    responseAppendLiteral(writer, accepted ? "ACCEPTED," : "REJECT,");
+    if (parsed && parsed->tagged) {
+        responseAppendLiteral(writer, "#");
+        responseAppendInt(writer, parsed->tag);
+        responseAppendLiteral(writer, ",");
     }
-    
-    // Handle empty command
-    if (strlen(cmd) == 0) {
-        response->result = COMMAND_REJECTED;
-        strcpy(response->response, "REJECT,,unknown command");
-        return;
+}
+
+static void writeRejected(ResponseWriter* writer, const ParsedCommand* parsed,
+                          const char* command, const char* reason) {
+    writeStatus(writer, false, parsed);
+    responseAppendLiteral(writer, command);
+    responseAppendLiteral(writer, ",");
+    responseAppendLiteral(writer, reason);
+}
+
+CommandResult writeResponse(ResponseWriter* writer, const char* echo,
+                            const ParsedCommand* parsed, ResponseEcho echoMode) {
+    const CommandSpec* spec = parsed ? commandSpecForOpcode(parsed->opcode) : NULL;
+
+    if (parsed && parsed->error == PARSE_BAD_FRAME) {
+        writeRejected(writer, parsed, echo, "bad frame");
+        return COMMAND_REJECTED;
     }
-    
-    // Basic commands
-    if (strcmp(cmd, "ON") == 0) {
-        response->result = COMMAND_ACCEPTED;
-        strcpy(response->response, "ACCEPTED,ON");
-    }
-    else if (strcmp(cmd, "OFF") == 0) {
-        response->result = COMMAND_ACCEPTED;
-        strcpy(response->response, "ACCEPTED,OFF");
-    }
-    // Color command
-    else if (strncmp(cmd, "COLOR,", 6) == 0) {
-        uint8_t r, g, b;
-        if (parseColorCommand(cmd, &r, &g, &b)) {
-            response->result = COMMAND_ACCEPTED;
-            snprintf(response->response, sizeof(response->response), 
-                    "ACCEPTED,%s", cmd);
-        } else {
-            response->result = COMMAND_REJECTED;
-            snprintf(response->response, sizeof(response->response), 
-                    "REJECT,%s,invalid format", cmd);
-        }
+
+    if (!spec || parsed->error == PARSE_UNKNOWN_COMMAND) {
+        writeRejected(writer, parsed, echo, "unknown command");
+        return COMMAND_REJECTED;
     }
-    // BLINK1 command
-    else if (strncmp(cmd, "BLINK1,", 7) == 0) {
-        uint8_t r, g, b;
-        long interval;
-        if (parseBlink1Command(cmd, &r, &g, &b, &interval)) {
-            response->result = COMMAND_ACCEPTED;
-            snprintf(response->response, sizeof(response->response), 
-                    "ACCEPTED,BLINK1,%d,%d,%d,interval=%ld", r, g, b, interval);
-        } else {
-            response->result = COMMAND_REJECTED;
-            snprintf(response->response, sizeof(response->response), 
-                    "REJECT,%s,invalid parameters", cmd);
-        }
+
+    if (parsed->error == PARSE_PAYLOAD_TOO_LONG) {
+        writeRejected(writer, parsed, echo, "payload too long");
+        return COMMAND_REJECTED;
     }
-    // BLINK2 command
-    else if (strncmp(cmd, "BLINK2,", 7) == 0) {
-        uint8_t r1, g1, b1, r2, g2, b2;
-        long interval;
-        if (parseBlink2Command(cmd, &r1, &g1, &b1, &r2, &g2, &b2, &interval)) {
-            response->result = COMMAND_ACCEPTED;
-            snprintf(response->response, sizeof(response->response), 
-                    "ACCEPTED,BLINK2,%d,%d,%d,%d,%d,%d,interval=%ld", 
-                    r1, g1, b1, r2, g2, b2, interval);
-        } else {
-            response->result = COMMAND_REJECTED;
-            snprintf(response->response, sizeof(response->response), 
-                    "REJECT,%s,invalid parameters", cmd);
-        }
+
+    if (parsed->error != PARSE_OK) {
+        writeRejected(writer, parsed, echo, spec->rejectReason);
+        return COMMAND_REJECTED;
     }
-    // RAINBOW command
-    else if (strncmp(cmd, "RAINBOW,", 8) == 0) {
-        long interval;
-        if (parseRainbowCommand(cmd, &interval)) {
-            response->result = COMMAND_ACCEPTED;
-            snprintf(response->response, sizeof(response->response), 
-                    "ACCEPTED,RAINBOW,interval=%ld", interval);
-        } else {
-            response->result = COMMAND_REJECTED;
-            snprintf(response->response, sizeof(response->response), 
-                    "REJECT,%s,invalid interval", cmd);
+
+    writeStatus(writer, true, parsed);
+    responseAppendVerb(writer, spec->verb, spec->verbLength);
+    if (echoMode == ECHO_COMPACT) return COMMAND_ACCEPTED;
+
+    for (uint8_t i = 0; i < parsed->argCount; i++) {
+        responseAppendLiteral(writer, ",");
+        if (i == parsed->argCount - 1) {
+            responseAppendLiteral(writer, spec->lastArgLabel);
         }
+        responseAppendInt(writer, parsed->args[i]);
     }
-    // Unknown command
-    else {
-        response->result = COMMAND_REJECTED;
-        snprintf(response->response, sizeof(response->response), 
-                "REJECT,%s,unknown command", cmd);
+
+    return COMMAND_ACCEPTED;
+}
+
+void quietModeSet(QuietMode* quiet, bool enabled) {
+    quiet->enabled = enabled;
+    quiet->sequence = 0;
+}
+
+// Session and link commands are answered even in quiet mode
+static bool quietExempt(CommandOpcode opcode) {
+    return opcode == OPCODE_QUIET || opcode == OPCODE_STATS ||
+           opcode == OPCODE_BAUD || opcode == OPCODE_PING || opcode == OPCODE_FLOW ||
+           opcode == OPCODE_RELIABLE || opcode == OPCODE_CAPS;
+}
+
+bool quietModeFilter(QuietMode* quiet, ParsedCommand* parsed, bool accepted) {
+    if (!quiet->enabled || quietExempt(parsed->opcode)) return true;
+
+    quiet->sequence++;
+    if (accepted) return false;
+
+    if (!parsed->tagged) {
+        parsed->tagged = true;
+        parsed->tag = quiet->sequence;
     }
+    return true;
+}
+
+void writeStats(ResponseWriter* writer, const SerialStats* stats) {
+    responseAppendLiteral(writer, ",tx_high=");
+    responseAppendInt(writer, stats->txHighWater);
+    responseAppendLiteral(writer, ",tx_size=");
+    responseAppendInt(writer, stats->txSize);
+    responseAppendLiteral(writer, ",tx_stalls=");
+    responseAppendInt(writer, stats->txStalls);
+    responseAppendLiteral(writer, ",payload_max=");
+    responseAppendInt(writer, stats->payloadMax);
+    responseAppendLiteral(writer, ",naks=");
+    responseAppendInt(writer, stats->naks);
+    responseAppendLiteral(writer, ",dups=");
+    responseAppendInt(writer, stats->duplicates);
+    responseAppendLiteral(writer, ",shows=");
+    responseAppendUnsigned(writer, stats->shows);
+    responseAppendLiteral(writer, ",skips=");
+    responseAppendUnsigned(writer, stats->showSkips);
+}
+
+uint32_t capsVerbMask(bool color, bool blink2, bool rainbow) {
+    uint32_t mask = 0;
+    for (uint8_t i = 0; i < COMMAND_TABLE_SIZE; i++) {
+        mask |= (uint32_t)1 << commandTable[i].opcode;
+    }
+    if (!color) {
+        mask &= ~(((uint32_t)1 << OPCODE_COLOR) | ((uint32_t)1 << OPCODE_PIXELS) |
+                  ((uint32_t)1 << OPCODE_FILL) | ((uint32_t)1 << OPCODE_FADE));
+    }
+    if (!blink2) mask &= ~((uint32_t)1 << OPCODE_BLINK2);
+    if (!rainbow) mask &= ~((uint32_t)1 << OPCODE_RAINBOW);
+    return mask;
+}
+
+void writeCaps(ResponseWriter* writer, const DeviceCaps* caps) {
+    static const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+    responseAppendLiteral(writer, ",proto=");
+    responseAppendInt(writer, PROTOCOL_VERSION);
+    responseAppendLiteral(writer, ",led=");
+    responseAppendLiteral(writer, caps->ledType);
+    responseAppendLiteral(writer, ",pixels=");
+    responseAppendInt(writer, caps->pixelCount);
+    responseAppendLiteral(writer, ",rx=");
+    responseAppendInt(writer, caps->rxSize);
+    responseAppendLiteral(writer, ",baud_max=");
+    responseAppendInt(writer, (long)caps->baudMax);
+    responseAppendLiteral(writer, ",verbs=");
+
+    // Hex without leading zeros, filled from the least significant digit
+    char digits[8];
+    uint8_t start = sizeof(digits);
+    uint32_t verbs = caps->verbs;
+    do {
+        digits[--start] = HEX_DIGITS[verbs & 0x0F];
+        verbs >>= 4;
+    } while (verbs != 0);
+    responseAppendVerb(writer, &digits[start], (uint8_t)(sizeof(digits) - start));
+}
+
+bool batchAccepted(const BatchStatus* batch) {
+    return batch->rejected == 0 && !batch->overflow;
+}
+
+CommandResult writeBatchSummary(ResponseWriter* writer, const BatchStatus* batch,
+                                const ParsedCommand* parsed) {
+    CommandResult result = batchAccepted(batch) ? COMMAND_ACCEPTED : COMMAND_REJECTED;
+
+    writeStatus(writer, result == COMMAND_ACCEPTED, parsed);
+    responseAppendLiteral(writer, "BATCH,");
+    responseAppendInt(writer, batch->count);
+    responseAppendLiteral(writer, ",");
+    for (uint8_t i = 0; i < batch->count; i++) {
+        responseAppendLiteral(writer, (batch->rejected >> i) & 1UL ? "0" : "1");
+    }
+    if (batch->overflow) {
+        responseAppendLiteral(writer, ",overflow");
+    }
+
+    return result;
+}
+
+void buildResponse(const char* cmd, const ParsedCommand* parsed, CommandResponse* response) {
+    if (!response) return;
+
+    ResponseWriter writer;
+    responseWriterInit(&writer, response->response, sizeof(response->response));
+    response->result = writeResponse(&writer, cmd, parsed, ECHO_FULL);
+}
+
+void processCommand(const char* cmd, CommandResponse* response) {
+    if (!response) return;
+
+    ParsedCommand parsed;
+    parseCommand(cmd, &parsed);
+
+    // The tag is already part of the status; echo the command after it
+    const char* echo = cmd;
+    if (parsed.tagged) {
+        while (*echo != ',') echo++;
+        echo++;
+    }
+    buildResponse(echo, &parsed, response);
 }
 
 void generateAcceptedResponse(const char* command, const char* additional, CommandResponse* response) {
     if (!response) return;
-    
+
+    ResponseWriter writer;
+    responseWriterInit(&writer, response->response, sizeof(response->response));
+
     response->result = COMMAND_ACCEPTED;
-    if (additional && strlen(additional) > 0) {
-        snprintf(response->response, sizeof(response->response), 
-                "ACCEPTED,%s,%s", command ? command : "", additional);
-    } else {
-        snprintf(response->response, sizeof(response->response), 
-                "ACCEPTED,%s", command ? command : "");
+    responseAppendLiteral(&writer, "ACCEPTED,");
+    responseAppendLiteral(&writer, command);
+    if (additional && additional[0] != '\0') {
+        responseAppendLiteral(&writer, ",");
+        responseAppendLiteral(&writer, additional);
     }
 }
 
 void generateRejectedResponse(const char* command, const char* reason, CommandResponse* response) {
     if (!response) return;
-    
+
+    ResponseWriter writer;
+    responseWriterInit(&writer, response->response, sizeof(response->response));
+
     response->result = COMMAND_REJECTED;
-    snprintf(response->response, sizeof(response->response), 
-            "REJECT,%s,%s", command ? command : "", reason ? reason : "");
-}
\ No newline at end of file
+    writeRejected(&writer, NULL, command, reason);
+}
@@ -15,13 +15,295 @@ typedef enum {
     COMMAND_UNKNOWN
 } CommandResult;
 
+#define RESPONSE_MAX_LENGTH 144  // Longest line: a tagged STATS with 32-bit counters
+
 // Response structure for command processing
 typedef struct {
     CommandResult result;
-    char response[128];  // Response string buffer
+    char response[RESPONSE_MAX_LENGTH];  // Response string buffer
 } CommandResponse;
 
-// Pure C functions for command parsing and validation
+// Integer-only decimal kernels (keep stdio formatting out of the firmware image)
+#define DECIMAL_MAX_CHARS (sizeof(long) * 3)  // Enough for any long, sign included
+
+// value = value * 10 + digit; false on a non-digit or when the result would overflow
+bool decimalAccumulate(long* value, char digit);
+// Write value in decimal to out (no NUL), returns the number of characters written
+uint8_t formatDecimal(long value, char* out);
+uint8_t formatUnsigned(unsigned long value, char* out);
+
+// Command opcodes produced by the tokenizer (values index the command table)
+typedef enum {
+    OPCODE_NONE = 0,
+    OPCODE_ON,
+    OPCODE_OFF,
+    OPCODE_COLOR,
+    OPCODE_BLINK1,
+    OPCODE_BLINK2,
+    OPCODE_RAINBOW,
+    OPCODE_ECHO,
+    OPCODE_QUIET,
+    OPCODE_STATS,
+    OPCODE_BAUD,
+    OPCODE_PING,
+    OPCODE_FLOW,
+    OPCODE_PIXELS,
+    OPCODE_RELIABLE,
+    OPCODE_CAPS,
+    OPCODE_FILL,
+    OPCODE_FADE
+} CommandOpcode;
+
+// Reported by CAPS; raised when the wire protocol changes incompatibly
+#define PROTOCOL_VERSION 1
+
+// Parse error codes
+typedef enum {
+    PARSE_OK = 0,
+    PARSE_UNKNOWN_COMMAND,  // Empty line or unrecognised verb
+    PARSE_INVALID_ARGS,     // Known verb with malformed or out-of-range arguments
+    PARSE_BAD_FRAME,        // Binary frame with bad CRC or COBS encoding
+    PARSE_PAYLOAD_TOO_LONG  // Payload larger than PAYLOAD_MAX_BYTES
+} ParseError;
+
+#define PARSED_COMMAND_MAX_ARGS 7
+
+// Tagged result of a single tokenizer pass over a command line
+typedef struct {
+    CommandOpcode opcode;
+    ParseError error;
+    uint8_t argCount;
+    long args[PARSED_COMMAND_MAX_ARGS];  // COLOR: r,g,b  BLINK1: r,g,b,interval
+                                         // BLINK2: r1,g1,b1,r2,g2,b2,interval  RAINBOW: interval
+                                         // FILL: start,count,r,g,b  FADE: r,g,b,duration,easing
+    bool tagged;                         // Line started with a "#<tag>," sequence prefix
+    uint16_t tag;                        // Echoed in the response so hosts can pipeline
+} ParsedCommand;
+
+#define SEQUENCE_TAG_MAX 65535
+
+// Inclusive range accepted for one numeric argument
+typedef struct {
+    long min;
+    long max;
+} ArgRange;
+
+// Command registry entry: everything needed to parse, validate and acknowledge a verb
+typedef struct {
+    const char* verb;
+    uint8_t verbLength;
+    CommandOpcode opcode;
+    uint8_t arity;              // Number of numeric arguments
+    const ArgRange* ranges;     // One range per argument
+    const char* lastArgLabel;   // Prefix for the last argument in ACCEPTED ("interval=") or NULL
+    const char* rejectReason;   // REJECT reason for malformed arguments
+    uint8_t payloadUnit;        // Payload bytes per unit after the arguments, 0 = no payload
+} CommandSpec;
+
+// Hash slots for verb lookup (power of two, at most 256)
+#ifndef COMMAND_REGISTRY_SLOTS
+#define COMMAND_REGISTRY_SLOTS 64
+#endif
+
+// Most verbs one registry holds: a load factor of 0.5 keeps probe chains short
+#define COMMAND_REGISTRY_CAPACITY (COMMAND_REGISTRY_SLOTS / 2)
+
+typedef char commandRegistrySlotsCheck[
+    (COMMAND_REGISTRY_SLOTS & (COMMAND_REGISTRY_SLOTS - 1)) == 0 && COMMAND_REGISTRY_SLOTS <= 256 ? 1 : -1];
+
+// Open-addressed verb index over a CommandSpec table
+typedef struct {
+    const CommandSpec* specs;
+    uint8_t count;
+    uint8_t slots[COMMAND_REGISTRY_SLOTS];  // Spec index + 1, 0 = empty
+} CommandRegistry;
+
+// Returns false, registering nothing, if count exceeds COMMAND_REGISTRY_CAPACITY
+bool commandRegistryInit(CommandRegistry* registry, const CommandSpec* specs, uint8_t count);
+const CommandSpec* commandRegistryFind(const CommandRegistry* registry, const char* verb, uint8_t length);
+
+// Built-in command table lookups
+const CommandSpec* findCommandSpec(const char* verb, uint8_t length);
+const CommandSpec* commandSpecForOpcode(CommandOpcode opcode);
+
+// Incremental decoder states
+typedef enum {
+    STREAM_IDLE = 0,    // Skipping leading whitespace
+    STREAM_TAG,         // Reading "#<tag>," digits (start of line only)
+    STREAM_VERB,        // Reading verb characters
+    STREAM_ARG_START,   // Expecting sign or first digit of an argument
+    STREAM_ARG_DIGITS,  // Reading argument digits
+    STREAM_PAYLOAD,     // Reading hex payload digits after the last argument
+    STREAM_TRAILING,    // Only whitespace allowed before the terminator
+    STREAM_DISCARD,     // Error found, skipping to the terminator
+    STREAM_COMPLETE     // command holds a finished item
+} CommandStreamState;
+
+#define COMMAND_VERB_MAX 16  // Longest verb kept (also the REJECT echo)
+
+// Batches: "OFF;COLOR,255,0,0\n" runs each item in order and is answered by
+// one summary line. Items past COMMAND_BATCH_MAX are rejected without running.
+#define COMMAND_SEPARATOR ';'
+#define COMMAND_BATCH_MAX 32
+
+// Per-line batch accounting
+typedef struct {
+    uint8_t count;      // Items completed on this line, current one included
+    uint32_t rejected;  // Bit i set when item i was rejected
+    bool overflow;      // More than COMMAND_BATCH_MAX items
+} BatchStatus;
+
+bool batchAccepted(const BatchStatus* batch);
+
+// Payload verbs (PIXELS,<start>,<hex>) carry hex digits after their last
+// argument. The decoder converts them in place and hands them out one unit
+// (e.g. one RGB pixel) at a time, so a payload is never buffered whole; its
+// unit count becomes the command's last argument. Payloads larger than
+// PAYLOAD_MAX_BYTES (BoardConfig.h) are rejected.
+#define PAYLOAD_UNIT_MAX 4
+
+// Byte-at-a-time command decoder: tokenizes and converts numbers as bytes
+// arrive, so a line is fully decoded when its newline is fed. No line buffer.
+typedef struct {
+    CommandStreamState state;
+    char verb[COMMAND_VERB_MAX + 1];  // NUL-terminated once the verb ends
+    uint8_t verbLength;
+    bool verbOverflow;
+    bool negative;
+    long value;                       // Argument being accumulated
+    const CommandSpec* spec;
+    ParsedCommand command;            // Valid when state == STREAM_COMPLETE
+    BatchStatus batch;                // Accounting for the current line
+    bool lineComplete;                // The newline (not a separator) ended this item
+    uint8_t unit[PAYLOAD_UNIT_MAX];   // Payload unit being assembled
+    uint8_t unitLength;               // Bytes in unit
+    bool highNibble;                  // Next hex digit starts a byte
+    uint16_t unitCount;               // Units completed in this payload
+    uint16_t payloadBytes;
+    bool unitReady;                   // The last byte fed completed unit[] (index unitCount - 1)
+} CommandStream;
+
+void commandStreamReset(CommandStream* stream);
+
+// Feed one byte. Returns true when a newline or separator completed an item
+// (a blank line alone is ignored); stream->command and stream->verb stay
+// valid until the next byte is fed. Payload units are signalled through
+// stream->unitReady instead, with the command's arguments already decoded.
+bool commandStreamFeed(CommandStream* stream, char c);
+
+// True when the completed item is part of a multi-command line
+bool commandStreamInBatch(const CommandStream* stream);
+
+// Response echo modes
+typedef enum {
+    ECHO_FULL = 0,  // ACCEPTED echoes the verb and its arguments
+    ECHO_COMPACT    // ACCEPTED echoes the verb only
+} ResponseEcho;
+
+#define RESPONSE_RESERVED_BYTES 3  // "\r\n" line end plus NUL terminator
+
+// Fixed-capacity response writer: appends straight into the caller's transmit
+// buffer (no heap, no intermediate copy). Output is truncated at capacity and
+// the buffer is always NUL-terminated.
+typedef struct {
+    char* buffer;
+    uint16_t capacity;  // Bytes usable for content (line end space is reserved)
+    uint16_t length;
+    bool overflow;
+} ResponseWriter;
+
+// size must exceed RESPONSE_RESERVED_BYTES
+void responseWriterInit(ResponseWriter* writer, char* buffer, uint16_t size);
+void responseAppendLiteral(ResponseWriter* writer, const char* text);
+void responseAppendVerb(ResponseWriter* writer, const char* verb, uint8_t length);
+void responseAppendInt(ResponseWriter* writer, long value);
+void responseAppendUnsigned(ResponseWriter* writer, unsigned long value);
+void responseEndLine(ResponseWriter* writer);
+
+// Write the ACCEPTED/REJECT line for a parsed command (echo is used on reject)
+CommandResult writeResponse(ResponseWriter* writer, const char* echo,
+                            const ParsedCommand* parsed, ResponseEcho echoMode);
+
+// Quiet session mode (QUIET,1): accepted commands get no response line and
+// rejects are tagged with the session sequence number unless the line
+// carried its own tag. Session and link commands (QUIET, STATS, BAUD, PING,
+// FLOW, RELIABLE, CAPS) are always answered.
+typedef struct {
+    bool enabled;
+    uint16_t sequence;  // Commands answered (or silenced) since QUIET,1
+} QuietMode;
+
+void quietModeSet(QuietMode* quiet, bool enabled);
+
+// Count one response unit; returns false when its line must be suppressed
+bool quietModeFilter(QuietMode* quiet, ParsedCommand* parsed, bool accepted);
+
+// Transport and LED counters and limits reported by STATS
+typedef struct {
+    uint16_t txHighWater;  // Most bytes ever waiting in the TX ring
+    uint16_t txSize;       // TX ring capacity
+    uint16_t txStalls;     // Responses that had to wait for TX ring space
+    uint16_t payloadMax;   // Largest payload one command may carry, in bytes
+    uint16_t naks;         // Reliable mode: NAKs sent for lost or corrupt frames
+    uint16_t duplicates;   // Reliable mode: retransmitted frames already received
+    uint32_t shows;        // Frames latched to the LED strip
+    uint32_t showSkips;    // Frames not latched because no pixel changed
+} SerialStats;
+
+// Append ,tx_high=<n>,tx_size=<n>,tx_stalls=<n>,payload_max=<n>,naks=<n>,dups=<n>,
+// shows=<n>,skips=<n> to an ACCEPTED,STATS line
+void writeStats(ResponseWriter* writer, const SerialStats* stats);
+
+// Device description reported by CAPS
+typedef struct {
+    const char* ledType;     // LEDController::getLEDType()
+    uint16_t pixelCount;
+    uint16_t rxSize;         // RX ring capacity
+    unsigned long baudMax;   // Fastest rate BAUD accepts
+    uint32_t verbs;          // Bit n set: opcode n runs without down-conversion
+} DeviceCaps;
+
+// Opcodes an LED runs as specified; COLOR, PIXELS, FILL and FADE only when the
+// LED supports color, BLINK2 and RAINBOW only with two-color blinks and rainbows
+uint32_t capsVerbMask(bool color, bool blink2, bool rainbow);
+
+// Append ,proto=<n>,led=<type>,pixels=<n>,rx=<bytes>,baud_max=<n>,verbs=<hex mask>
+// to an ACCEPTED,CAPS line
+void writeCaps(ResponseWriter* writer, const DeviceCaps* caps);
+
+// Write the batch summary once the line is complete:
+// ACCEPTED|REJECT,BATCH,<count>,<status bits, '1' = accepted, first item first>[,overflow]
+// (parsed supplies the line's sequence tag)
+CommandResult writeBatchSummary(ResponseWriter* writer, const BatchStatus* batch,
+                                const ParsedCommand* parsed);
+
+// Binary protocol: payload = opcode, arguments as fixed-width little-endian
+// unsigned integers (width from each argument's range: 1, 2 or 4 bytes), CRC-8.
+// Responses carry opcode, ParseError, CRC-8.
+#define RESPONSE_FRAME_PAYLOAD 3
+
+uint8_t commandArgWidth(const ArgRange* range);
+bool decodeCommandFrame(const uint8_t* payload, uint8_t length, ParsedCommand* parsed);
+// Write a complete response frame to out (FRAME_ENCODED_SIZE(RESPONSE_FRAME_PAYLOAD) bytes)
+uint8_t encodeResponseFrame(const ParsedCommand* parsed, uint8_t* out);
+
+// Reliable mode (RELIABLE,1, see ReliableLink.h): the payload starts with a
+// sequence number and responses carry it back: sequence, opcode, ParseError.
+// Both directions seed the CRC-8 with the payload length (crc8Seeded).
+// sequence is only meaningful when parsed->error != PARSE_BAD_FRAME.
+#define RELIABLE_RESPONSE_PAYLOAD 4
+
+bool decodeReliableFrame(const uint8_t* payload, uint8_t length, uint8_t* sequence, ParsedCommand* parsed);
+uint8_t encodeReliableResponseFrame(uint8_t sequence, const ParsedCommand* parsed, uint8_t* out);
+
+// Single-pass tokenizer over one command (leading/trailing whitespace ignored,
+// stops at a newline or separator): fills parsed and returns true when error == PARSE_OK
+bool parseCommand(const char* cmd, ParsedCommand* parsed);
+
+// Build ACCEPTED/REJECT response from a parsed command (cmd is echoed on reject)
+void buildResponse(const char* cmd, const ParsedCommand* parsed, CommandResponse* response);
+
+// Pure C functions for command parsing and validation (wrappers around parseCommand)
 bool parseColorCommand(const char* cmd, uint8_t* r, uint8_t* g, uint8_t* b);
 bool parseBlink1Command(const char* cmd, uint8_t* r, uint8_t* g, uint8_t* b, long* interval);
 bool parseBlink2Command(const char* cmd, uint8_t* r1, uint8_t* g1, uint8_t* b1, 
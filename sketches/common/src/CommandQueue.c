@@ -0,0 +1,152 @@
+#include "CommandQueue.h"
+#include <string.h>
+
+void commandQueueInit(CommandQueue* queue, QueuedCommand* storage, uint8_t size) {
+    queue->entries = storage;
+    queue->mask = (uint8_t)(size - 1);
+    commandQueueClear(queue);
+}
+
+void commandQueueClear(CommandQueue* queue) {
+    queue->head = 0;
+    queue->tail = 0;
+    queue->overflow = 0;
+}
+
+uint8_t commandQueueCount(const CommandQueue* queue) {
+    return (uint8_t)(queue->head - queue->tail);
+}
+
+bool commandQueueFull(const CommandQueue* queue) {
+    return commandQueueCount(queue) > queue->mask;
+}
+
+// Next free entry, or NULL (and one more overflow) when full
+static QueuedCommand* queueReserve(CommandQueue* queue) {
+    if (commandQueueFull(queue)) {
+        if (queue->overflow < UINT16_MAX) queue->overflow++;
+        return NULL;
+    }
+    return &queue->entries[queue->head & queue->mask];
+}
+
+bool commandQueuePushStream(CommandQueue* queue, CommandStream* stream) {
+    QueuedCommand* entry = queueReserve(queue);
+    if (!entry) {
+        if (commandStreamInBatch(stream) && stream->batch.count > 0) {
+            stream->batch.rejected |= 1UL << (stream->batch.count - 1);
+        }
+        return false;
+    }
+
+    entry->command = stream->command;
+    memcpy(entry->verb, stream->verb, sizeof(entry->verb));
+    entry->source = QUEUED_TEXT;
+    entry->inBatch = commandStreamInBatch(stream);
+    entry->lineComplete = stream->lineComplete;
+    entry->batch = stream->batch;
+    queue->head++;
+    return true;
+}
+
+bool commandQueueRehomeSummary(CommandQueue* queue, const CommandStream* stream) {
+    if (!stream->lineComplete || !commandStreamInBatch(stream)) return false;
+
+    // Only the line being decoded can have an unanswered batch item queued
+    if (commandQueueCount(queue) > 0) {
+        QueuedCommand* newest = &queue->entries[(uint8_t)(queue->head - 1) & queue->mask];
+        if (newest->source == QUEUED_TEXT && newest->inBatch && !newest->lineComplete) {
+            newest->lineComplete = true;
+            newest->batch = stream->batch;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool commandQueuePushFrame(CommandQueue* queue, const ParsedCommand* parsed) {
+    QueuedCommand* entry = queueReserve(queue);
+    if (!entry) return false;
+
+    entry->command = *parsed;
+    entry->verb[0] = '\0';
+    entry->source = QUEUED_FRAME;
+    entry->inBatch = false;
+    entry->lineComplete = true;
+    queue->head++;
+    return true;
+}
+
+const QueuedCommand* commandQueueFront(const CommandQueue* queue) {
+    if (queue->head == queue->tail) return NULL;
+    return &queue->entries[queue->tail & queue->mask];
+}
+
+void commandQueueDrop(CommandQueue* queue) {
+    if (queue->head != queue->tail) queue->tail++;
+}
+
+uint16_t commandQueueTakeOverflow(CommandQueue* queue) {
+    uint16_t dropped = queue->overflow;
+    queue->overflow = 0;
+    return dropped;
+}
+
+void writeQueueOverflow(ResponseWriter* writer, uint16_t dropped) {
+    responseAppendLiteral(writer, "REJECT,QUEUE,overflow,");
+    responseAppendInt(writer, dropped);
+}
+
+void flowControlSet(FlowControl* flow, bool enabled) {
+    flow->enabled = enabled;
+    flow->granting = enabled;
+    flow->pending = 0;
+}
+
+void flowControlRelease(FlowControl* flow, uint16_t count) {
+    if (flow->enabled) flow->pending += count;
+}
+
+uint16_t flowControlTake(FlowControl* flow, uint16_t freeSlots) {
+    // The grant covers every free slot, including any released since FLOW,1
+    uint16_t credits = flow->granting ? freeSlots : flow->pending;
+    flow->granting = false;
+    flow->pending = 0;
+    return credits;
+}
+
+void writeCredit(ResponseWriter* writer, uint16_t count) {
+    responseAppendLiteral(writer, "CREDIT,");
+    responseAppendInt(writer, count);
+}
+
+void baudConfirmReset(BaudConfirm* confirm) {
+    confirm->pending = false;
+    confirm->fence = 0;
+    confirm->switchMillis = 0;
+}
+
+void baudConfirmStart(BaudConfirm* confirm, uint8_t queued, uint32_t now) {
+    confirm->pending = true;
+    confirm->fence = queued;
+    confirm->switchMillis = now;
+}
+
+void baudConfirmQueued(BaudConfirm* confirm, bool valid) {
+    if (confirm->fence > 0) {
+        confirm->fence--;  // Decoded at the old rate
+        return;
+    }
+    if (valid) confirm->pending = false;
+}
+
+void baudConfirmDirect(BaudConfirm* confirm) {
+    confirm->pending = false;
+}
+
+bool baudConfirmExpired(BaudConfirm* confirm, uint32_t now, uint32_t windowMs) {
+    if (!confirm->pending || now - confirm->switchMillis < windowMs) return false;
+
+    confirm->pending = false;
+    return true;
+}
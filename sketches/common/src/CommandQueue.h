@@ -0,0 +1,114 @@
+#ifndef COMMAND_QUEUE_H
+#define COMMAND_QUEUE_H
+
+#include "CommandProcessor.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    QUEUED_TEXT = 0,  // From the text decoder (single command or batch item)
+    QUEUED_FRAME      // From a binary frame
+} QueuedSource;
+
+// One decoded command, self-contained so it can run loops after decoding
+typedef struct {
+    ParsedCommand command;
+    char verb[COMMAND_VERB_MAX + 1];  // Reject echo (text only)
+    QueuedSource source;
+    bool inBatch;
+    bool lineComplete;                // Last item of its line: answer it
+    BatchStatus batch;                // Line summary, valid when lineComplete
+} QueuedCommand;
+
+// Bounded FIFO of decoded commands over caller-provided storage. The size
+// must be a power of two (masked indices, as in RingBuffer). A command that
+// arrives while the queue is full is dropped and counted, never run.
+typedef struct {
+    QueuedCommand* entries;
+    uint8_t mask;
+    uint8_t head;
+    uint8_t tail;
+    uint16_t overflow;  // Commands dropped since the last commandQueueTakeOverflow()
+} CommandQueue;
+
+// size must be a power of two, at most 128
+void commandQueueInit(CommandQueue* queue, QueuedCommand* storage, uint8_t size);
+void commandQueueClear(CommandQueue* queue);
+uint8_t commandQueueCount(const CommandQueue* queue);
+bool commandQueueFull(const CommandQueue* queue);
+
+// Queue the item the stream just completed. When full the item is counted
+// as overflow and, inside a batch, marked rejected in the line's summary.
+bool commandQueuePushStream(CommandQueue* queue, CommandStream* stream);
+bool commandQueuePushFrame(CommandQueue* queue, const ParsedCommand* parsed);
+
+// After commandQueuePushStream() failed: if the dropped item ended a batch
+// line, the line's summary moves to its newest queued item, which answers
+// the line when it runs. Returns true when no item of the line is still
+// queued; the caller must then send the summary itself.
+bool commandQueueRehomeSummary(CommandQueue* queue, const CommandStream* stream);
+
+// Oldest entry (NULL when empty); commandQueueDrop() releases it
+const QueuedCommand* commandQueueFront(const CommandQueue* queue);
+void commandQueueDrop(CommandQueue* queue);
+
+// Returns the overflow count and resets it
+uint16_t commandQueueTakeOverflow(CommandQueue* queue);
+
+// REJECT,QUEUE,overflow,<dropped>
+void writeQueueOverflow(ResponseWriter* writer, uint16_t dropped);
+
+// Credit-based flow control (FLOW,1): one credit is one queue slot. The host
+// starts with the free slots granted by FLOW,1 and spends one credit per
+// command (each batch item counts); the device returns a credit for every
+// entry it runs or drops, collected into one CREDIT line per loop.
+typedef struct {
+    bool enabled;
+    bool granting;     // FLOW,1 ran: the next take grants every free slot
+    uint16_t pending;  // Credits freed but not yet sent to the host
+} FlowControl;
+
+// Enabling grants the slots free at the next flowControlTake(), so the grant
+// does not depend on whether FLOW held a queue slot; disabling discards
+// pending credits
+void flowControlSet(FlowControl* flow, bool enabled);
+void flowControlRelease(FlowControl* flow, uint16_t count);
+
+// Returns the credits to advertise now (0 when disabled) and resets them.
+// freeSlots is the queue's free space, used for the grant after FLOW,1.
+uint16_t flowControlTake(FlowControl* flow, uint16_t freeSlots);
+
+// CREDIT,<count>
+void writeCredit(ResponseWriter* writer, uint16_t count);
+
+// Baud rate confirmation (BAUD, PING): a new rate is kept only if a valid
+// command decoded at that rate runs within the confirmation window.
+// Entries still queued when the rate switched were decoded at the old rate,
+// so they are fenced off and confirm nothing.
+typedef struct {
+    bool pending;
+    uint8_t fence;          // Queued entries decoded before the switch
+    uint32_t switchMillis;
+} BaudConfirm;
+
+void baudConfirmReset(BaudConfirm* confirm);
+
+// The rate switched at now with queued entries still waiting to run
+void baudConfirmStart(BaudConfirm* confirm, uint8_t queued, uint32_t now);
+
+// A queued entry runs; valid ones confirm the rate unless fenced off
+void baudConfirmQueued(BaudConfirm* confirm, bool valid);
+
+// A valid command that bypassed the queue (reliable frame) confirms the rate
+void baudConfirmDirect(BaudConfirm* confirm);
+
+// True once when the window closed without confirmation: fall back
+bool baudConfirmExpired(BaudConfirm* confirm, uint32_t now, uint32_t windowMs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COMMAND_QUEUE_H
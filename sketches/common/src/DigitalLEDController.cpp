@@ -1,7 +1,7 @@
 #include "DigitalLEDController.h"
 
 DigitalLEDController::DigitalLEDController(int ledPin) 
-  : pin(ledPin), currentState(LOW), blinkEnabled(false), blinkState(false) {
+  : pin(ledPin), currentState(LOW), stagedState(LOW), pixelStaged(false), blinkEnabled(false) {
 }
 
 void DigitalLEDController::initialize() {
@@ -11,14 +11,10 @@ void DigitalLEDController::initialize() {
 }
 
 void DigitalLEDController::update() {
-  if (!animationEnabled) return;
+  if (animationStepsDue() == 0) return;
   
-  unsigned long currentMillis = millis();
-  if (currentMillis - previousUpdateMillis >= currentInterval) {
-    previousUpdateMillis = currentMillis;
-    blinkState = !blinkState;
-    setLEDState(blinkState ? HIGH : LOW);
-  }
+  // Off on even steps, on on odd ones, however many steps a stall skipped
+  setLEDState((animationClock.step & 1) ? HIGH : LOW);
 }
 
 void DigitalLEDController::turnOn() {
@@ -33,26 +29,33 @@ void DigitalLEDController::turnOff() {
 
 void DigitalLEDController::setColor(uint8_t r, uint8_t g, uint8_t b) {
   // Digital LEDs ignore color - just turn on
+  (void)r;
+  (void)g;
+  (void)b;
   stopAnimation();
   setLEDState(HIGH);
 }
 
 void DigitalLEDController::startBlink(uint8_t r, uint8_t g, uint8_t b, long interval) {
-  currentInterval = interval;
-  animationEnabled = true;
-  blinkState = false;
-  previousUpdateMillis = millis();
+  (void)r;
+  (void)g;
+  (void)b;
+  startAnimationClock(interval);
   setLEDState(LOW); // Start with LED off
 }
 
 void DigitalLEDController::startBlink2(uint8_t r1, uint8_t g1, uint8_t b1, 
                                       uint8_t r2, uint8_t g2, uint8_t b2, long interval) {
   // Not supported - fall back to single blink
+  (void)r2;
+  (void)g2;
+  (void)b2;
   startBlink(r1, g1, b1, interval);
 }
 
 void DigitalLEDController::startRainbow(long interval) {
   // Not supported - turn on solid
+  (void)interval;
   turnOn();
 }
 
@@ -60,6 +63,24 @@ void DigitalLEDController::stopAnimation() {
   animationEnabled = false;
 }
 
+void DigitalLEDController::setPixel(uint16_t index, uint8_t r, uint8_t g, uint8_t b) {
+  if (index != 0) return;
+  stagedState = (r | g | b) ? HIGH : LOW;
+  pixelStaged = true;
+}
+
+void DigitalLEDController::show() {
+  stopAnimation();
+  if (pixelStaged) {
+    setLEDState(stagedState);
+    pixelStaged = false;
+  }
+}
+
+void DigitalLEDController::discardPixels() {
+  pixelStaged = false;
+}
+
 void DigitalLEDController::setLEDState(int state) {
   currentState = state;
   digitalWrite(pin, state);
@@ -29,6 +29,12 @@ public:
   void startRainbow(long interval) override;
   void stopAnimation() override;
   
+  // Pixel access (one pixel: any non-black color turns the LED on)
+  uint16_t getPixelCount() const override { return 1; }
+  void setPixel(uint16_t index, uint8_t r, uint8_t g, uint8_t b) override;
+  void show() override;
+  void discardPixels() override;
+  
   // Capabilities
   bool supportsColor() const override { return false; }
   bool supportsRainbow() const override { return false; }
@@ -38,8 +44,9 @@ public:
 private:
   int pin;
   int currentState;
+  int stagedState;
+  bool pixelStaged;  // stagedState holds a pixel not yet shown
   bool blinkEnabled;
-  bool blinkState;
   
   void setLEDState(int state);
 };
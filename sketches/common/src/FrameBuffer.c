@@ -0,0 +1,113 @@
+#include "FrameBuffer.h"
+
+#include <stddef.h>
+
+static void markDirty(FrameBuffer* fb, uint16_t first, uint16_t end) {
+    if (fb->dirtyFirst >= fb->dirtyEnd) {
+        fb->dirtyFirst = first;
+        fb->dirtyEnd = end;
+        return;
+    }
+    if (first < fb->dirtyFirst) fb->dirtyFirst = first;
+    if (end > fb->dirtyEnd) fb->dirtyEnd = end;
+}
+
+void frameBufferInit(FrameBuffer* fb, uint8_t* storage, uint16_t count) {
+    fb->data = storage;
+    fb->count = storage ? count : 0;
+    for (uint32_t i = 0; i < (uint32_t)fb->count * 3; i++) {
+        fb->data[i] = 0;
+    }
+    // The strip's contents are unknown until the first show()
+    fb->dirtyFirst = 0;
+    fb->dirtyEnd = fb->count;
+}
+
+void frameBufferClear(FrameBuffer* fb) {
+    frameBufferFill(fb, 0, fb->count, 0, 0, 0);
+}
+
+void frameBufferSet(FrameBuffer* fb, uint16_t index, uint8_t r, uint8_t g, uint8_t b) {
+    if (index >= fb->count) return;
+
+    uint8_t* pixel = &fb->data[(uint32_t)index * 3];
+    if (pixel[0] == r && pixel[1] == g && pixel[2] == b) return;
+
+    pixel[0] = r;
+    pixel[1] = g;
+    pixel[2] = b;
+    markDirty(fb, index, (uint16_t)(index + 1));
+}
+
+uint16_t frameBufferFill(FrameBuffer* fb, uint16_t first, uint16_t count, uint8_t r, uint8_t g, uint8_t b) {
+    if (first >= fb->count) return 0;
+    if (count > fb->count - first) count = (uint16_t)(fb->count - first);
+
+    // Only pixels that change widen the dirty range
+    uint16_t changedFirst = count;
+    uint16_t changedEnd = 0;
+    uint8_t* pixel = &fb->data[(uint32_t)first * 3];
+    for (uint16_t i = 0; i < count; i++, pixel += 3) {
+        if (pixel[0] == r && pixel[1] == g && pixel[2] == b) continue;
+
+        pixel[0] = r;
+        pixel[1] = g;
+        pixel[2] = b;
+        if (changedFirst == count) changedFirst = i;
+        changedEnd = (uint16_t)(i + 1);
+    }
+    if (changedEnd > 0) {
+        markDirty(fb, (uint16_t)(first + changedFirst), (uint16_t)(first + changedEnd));
+    }
+    return count;
+}
+
+const uint8_t* frameBufferPixel(const FrameBuffer* fb, uint16_t index) {
+    if (index >= fb->count) return NULL;
+    return &fb->data[(uint32_t)index * 3];
+}
+
+bool frameBufferTakeDirty(FrameBuffer* fb, uint16_t* first, uint16_t* end) {
+    if (fb->dirtyFirst >= fb->dirtyEnd) return false;
+
+    *first = fb->dirtyFirst;
+    *end = fb->dirtyEnd;
+    fb->dirtyFirst = 0;
+    fb->dirtyEnd = 0;
+    return true;
+}
+
+void frameStageInit(FrameStage* stage, uint8_t* storage, uint16_t count) {
+    stage->data = storage;
+    stage->count = storage ? count : 0;
+    frameStageDiscard(stage);
+}
+
+void frameStageSet(FrameStage* stage, uint16_t index, uint8_t r, uint8_t g, uint8_t b) {
+    if (index >= stage->count) return;
+
+    if (stage->first >= stage->end || index < stage->first || index > stage->end) {
+        stage->first = index;  // Not contiguous with the run: start over
+        stage->end = index;
+    }
+    uint8_t* pixel = &stage->data[(uint32_t)index * 3];
+    pixel[0] = r;
+    pixel[1] = g;
+    pixel[2] = b;
+    if (index == stage->end) stage->end = (uint16_t)(index + 1);
+}
+
+void frameStageDiscard(FrameStage* stage) {
+    stage->first = 0;
+    stage->end = 0;
+}
+
+uint16_t frameStageCommit(FrameStage* stage, FrameBuffer* fb) {
+    uint16_t copied = 0;
+    for (uint16_t i = stage->first; i < stage->end && i < fb->count; i++, copied++) {
+        const uint8_t* pixel = &stage->data[(uint32_t)i * 3];
+        frameBufferSet(fb, i, pixel[0], pixel[1], pixel[2]);
+    }
+    frameStageDiscard(stage);
+    return copied;
+}
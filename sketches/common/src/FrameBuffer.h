@@ -0,0 +1,74 @@
+#ifndef FRAME_BUFFER_H
+#define FRAME_BUFFER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Full-strip framebuffer over caller-provided storage, 3 bytes (R, G, B)
+// per pixel. Effects render every pixel here and the LED driver latches the
+// whole buffer with a single show() per frame. Colors are kept unscaled, so
+// a pixel reads back exactly as written (strip brightness is applied by the
+// driver on output).
+//
+// Writes that leave a pixel unchanged are dropped, and the pixels that did
+// change are tracked as one dirty range, so the driver can skip show() for
+// an identical frame and copy only the range that changed.
+typedef struct {
+    uint8_t* data;
+    uint16_t count;
+    uint16_t dirtyFirst;  // Changed pixels since the last frameBufferTakeDirty(),
+    uint16_t dirtyEnd;    // [dirtyFirst, dirtyEnd); empty when first >= end
+} FrameBuffer;
+
+// storage must hold count * 3 bytes; the buffer starts cleared and wholly
+// dirty, so the first frame is always shown
+void frameBufferInit(FrameBuffer* fb, uint8_t* storage, uint16_t count);
+void frameBufferClear(FrameBuffer* fb);
+
+// Writes past the end of the strip are ignored
+void frameBufferSet(FrameBuffer* fb, uint16_t index, uint8_t r, uint8_t g, uint8_t b);
+
+// Fill count pixels from first, clipped to the strip; returns pixels written
+uint16_t frameBufferFill(FrameBuffer* fb, uint16_t first, uint16_t count, uint8_t r, uint8_t g, uint8_t b);
+
+// R, G, B of one pixel, or NULL past the end of the strip
+const uint8_t* frameBufferPixel(const FrameBuffer* fb, uint16_t index);
+
+// Take the dirty range [*first, *end) and mark the buffer clean; false when
+// nothing changed since the last call
+bool frameBufferTakeDirty(FrameBuffer* fb, uint16_t* first, uint16_t* end);
+
+// Pixels staged by a streamed command (PIXELS) outside the framebuffer, so
+// a command rejected part-way through its payload leaves the strip and any
+// running effect untouched. Staged pixels form one run; they reach a
+// framebuffer only through frameStageCommit(), once the command is accepted.
+typedef struct {
+    uint8_t* data;   // Same layout as the framebuffer it commits to
+    uint16_t count;
+    uint16_t first;  // Staged run [first, end); empty when first >= end
+    uint16_t end;
+} FrameStage;
+
+// storage must hold count * 3 bytes; the stage starts empty
+void frameStageInit(FrameStage* stage, uint8_t* storage, uint16_t count);
+
+// Stage one pixel. It must fall inside the run or extend it by one (as
+// payload units do); any other index starts a new run. Writes past the end
+// of the strip are ignored.
+void frameStageSet(FrameStage* stage, uint16_t index, uint8_t r, uint8_t g, uint8_t b);
+
+void frameStageDiscard(FrameStage* stage);
+
+// Copy the staged run into fb (only pixels that change dirty it) and empty
+// the stage; returns the pixels copied
+uint16_t frameStageCommit(FrameStage* stage, FrameBuffer* fb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRAME_BUFFER_H
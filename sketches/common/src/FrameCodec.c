@@ -0,0 +1,90 @@
+#include "FrameCodec.h"
+
+uint8_t crc8(const uint8_t* data, uint8_t length) {
+    return crc8Seeded(0x00, data, length);
+}
+
+uint8_t crc8Seeded(uint8_t seed, const uint8_t* data, uint8_t length) {
+    uint8_t crc = seed;
+
+    for (uint8_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+uint8_t frameEncode(const uint8_t* payload, uint8_t length, uint8_t* out) {
+    uint8_t written = 0;
+    out[written++] = FRAME_DELIMITER;
+
+    // COBS: each block starts with the offset to the next zero (or block end)
+    uint8_t codeIndex = written++;
+    uint8_t code = 1;
+    for (uint8_t i = 0; i < length; i++) {
+        if (payload[i] == 0) {
+            out[codeIndex] = code;
+            codeIndex = written++;
+            code = 1;
+        } else {
+            out[written++] = payload[i];
+            if (++code == 0xFF) {
+                out[codeIndex] = code;
+                codeIndex = written++;
+                code = 1;
+            }
+        }
+    }
+    out[codeIndex] = code;
+
+    out[written++] = FRAME_DELIMITER;
+    return written;
+}
+
+void frameDecoderReset(FrameDecoder* decoder) {
+    decoder->length = 0;
+    decoder->code = 0xFF;
+    decoder->remaining = 0;
+    decoder->active = false;
+    decoder->error = false;
+}
+
+static void frameAppend(FrameDecoder* decoder, uint8_t byte) {
+    if (decoder->length < FRAME_MAX_PAYLOAD) {
+        decoder->payload[decoder->length++] = byte;
+    } else {
+        decoder->error = true;
+    }
+}
+
+bool frameDecoderFeed(FrameDecoder* decoder, uint8_t byte) {
+    if (byte == FRAME_DELIMITER) {
+        if (!decoder->active) {
+            frameDecoderReset(decoder);
+            decoder->active = true;  // Leading delimiter opens a frame
+            return false;
+        }
+
+        bool complete = decoder->length > 0 || decoder->code != 0xFF;
+        if (decoder->remaining != 0) decoder->error = true;  // Truncated block
+        decoder->active = false;
+        return complete;
+    }
+
+    if (!decoder->active) return false;
+
+    if (decoder->remaining == 0) {
+        // Code byte: the previous block ended in an implicit zero unless it was full
+        if (decoder->code != 0xFF) frameAppend(decoder, 0);
+        decoder->code = byte;
+        decoder->remaining = byte - 1;
+    } else {
+        frameAppend(decoder, byte);
+        decoder->remaining--;
+    }
+
+    return false;
+}
@@ -0,0 +1,52 @@
+#ifndef FRAME_CODEC_H
+#define FRAME_CODEC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Binary framing: each frame is 0x00, COBS(payload + CRC-8), 0x00.
+// The leading delimiter switches the receiver out of text mode; COBS
+// guarantees the payload never contains 0x00, so text and binary coexist.
+#define FRAME_DELIMITER 0x00
+#define FRAME_MAX_PAYLOAD 32  // Decoded bytes, CRC included
+
+// Worst-case encoded size of a payload: delimiters + COBS overhead
+#define FRAME_ENCODED_SIZE(payloadLength) ((payloadLength) + (payloadLength) / 254 + 3)
+
+// CRC-8, polynomial 0x07, initial value 0x00
+uint8_t crc8(const uint8_t* data, uint8_t length);
+
+// CRC-8 with another initial value. Reliable frames seed it with the payload
+// length: with a zero seed two frames merged by a lost delimiter still pass,
+// since a frame followed by its own CRC leaves the register at zero.
+uint8_t crc8Seeded(uint8_t seed, const uint8_t* data, uint8_t length);
+
+// Encode payload into out as a complete frame (both delimiters), returns bytes written
+uint8_t frameEncode(const uint8_t* payload, uint8_t length, uint8_t* out);
+
+// Streaming COBS decoder
+typedef struct {
+    uint8_t payload[FRAME_MAX_PAYLOAD];
+    uint8_t length;
+    uint8_t code;       // Code byte of the current COBS block
+    uint8_t remaining;  // Data bytes left in the current block
+    bool active;        // Inside a frame (after the leading delimiter)
+    bool error;         // Overflow or truncated block
+} FrameDecoder;
+
+void frameDecoderReset(FrameDecoder* decoder);
+
+// Feed one byte received while decoder->active (or a delimiter to open a frame).
+// Returns true when a closing delimiter completed a non-empty frame; check
+// decoder->error before using decoder->payload/length.
+bool frameDecoderFeed(FrameDecoder* decoder, uint8_t byte);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // FRAME_CODEC_H
@@ -2,6 +2,8 @@
 #define LED_CONTROLLER_H
 
 #include <Arduino.h>
+#include <limits.h>
+#include "AnimationClock.h"
 
 /**
  * Abstract base class for LED control across different board types
@@ -28,6 +30,45 @@ public:
                           uint8_t r2, uint8_t g2, uint8_t b2, long interval) = 0;
   virtual void startRainbow(long interval) = 0;
   virtual void stopAnimation() = 0;
+  
+  // Crossfade from the current output to a color over duration ms (FADE).
+  // Controllers that cannot blend jump straight to the target.
+  virtual void startFade(uint8_t r, uint8_t g, uint8_t b, uint16_t duration, uint8_t curve) {
+    (void)duration;
+    (void)curve;
+    if (r | g | b) {
+      setColor(r, g, b);
+    } else {
+      turnOff();
+    }
+  }
+
+  // === Pixel Access (PIXELS, FILL) ===
+  // setPixel() stages one pixel without touching the output, so a running
+  // animation carries on while a payload arrives. show() stops any animation
+  // and latches the staged pixels (the command was accepted);
+  // discardPixels() drops them (it was rejected). Indices past
+  // getPixelCount() are ignored.
+  virtual uint16_t getPixelCount() const = 0;
+  virtual void setPixel(uint16_t index, uint8_t r, uint8_t g, uint8_t b) = 0;
+  virtual void show() = 0;
+  virtual void discardPixels() = 0;
+
+  // Set count pixels from first (FILL), clipped to the strip, and show them
+  virtual void fillPixels(uint16_t first, uint16_t count, uint8_t r, uint8_t g, uint8_t b) {
+    discardPixels();
+    for (uint32_t i = first; i < (uint32_t)first + count && i < getPixelCount(); i++) {
+      setPixel((uint16_t)i, r, g, b);
+    }
+    show();
+  }
+
+  // === Show Counters (STATS) ===
+  // Frames latched to the strip, and frames skipped because no pixel changed.
+  // 32-bit, so they last for years at 60 fps; controllers without a strip
+  // leave them at 0.
+  uint32_t getShowCount() const { return showCount; }
+  uint32_t getShowSkipCount() const { return showSkipCount; }
 
   // === Capability Detection ===
   virtual bool supportsColor() const = 0;
@@ -36,10 +77,29 @@ public:
   virtual const char* getLEDType() const = 0;  // "Digital", "RGB", "Matrix", etc.
 
 protected:
-  // Common timing variables that derived classes can use
-  unsigned long previousUpdateMillis = 0;
-  long currentInterval = 500;
+  // Animation timing shared by derived classes: render from
+  // animationClock.step (whole intervals since the start), never by
+  // counting update() calls, so stalls cannot slow an animation down
+  void startAnimationClock(long interval) {
+    if (interval < 1) interval = 1;
+#if LONG_MAX > UINT32_MAX
+    // A 64-bit long outranges the 32-bit clock: saturate rather than wrap
+    // (4294967296 would otherwise run as a 1 ms clock)
+    if (interval > (long)UINT32_MAX) interval = (long)UINT32_MAX;
+#endif
+    animationClockStart(&animationClock, millis(), (uint32_t)interval);
+    animationEnabled = true;
+  }
+  
+  // Steps due since the last call; 0 when none are due or no animation runs
+  uint32_t animationStepsDue() {
+    return animationEnabled ? animationClockAdvance(&animationClock, millis()) : 0;
+  }
+  
+  AnimationClock animationClock = { 0, 500, 0 };
   bool animationEnabled = false;
+  uint32_t showCount = 0;
+  uint32_t showSkipCount = 0;
 };
 
 #endif // LED_CONTROLLER_H
\ No newline at end of file
@@ -1,9 +1,19 @@
 #include "NeoPixelLEDController.h"
+#include "ColorTables.h"
 
 NeoPixelLEDController::NeoPixelLEDController(int dataPin, int powerPin, int ledCount, int brightness)
   : pixels(ledCount, dataPin, NEO_GRB + NEO_KHZ800), powerPin(powerPin), 
-    animationMode(NONE), blinkState(false), rainbowHue(0) {
+    animationMode(NONE) {
   pixels.setBrightness(brightness);
+  frameBufferInit(&frame, new uint8_t[(size_t)ledCount * 3], (uint16_t)ledCount);
+  frameStageInit(&staged, new uint8_t[(size_t)ledCount * 3], (uint16_t)ledCount);
+  fadeFrom = new uint8_t[(size_t)ledCount * 3];
+}
+
+NeoPixelLEDController::~NeoPixelLEDController() {
+  delete[] frame.data;
+  delete[] staged.data;
+  delete[] fadeFrom;
 }
 
 void NeoPixelLEDController::initialize() {
@@ -13,40 +23,47 @@ void NeoPixelLEDController::initialize() {
   }
   
   pixels.begin();
-  pixels.clear();
-  pixels.show();
+  frameBufferInit(&frame, frame.data, frame.count);  // Cleared and wholly dirty
+  frameStageDiscard(&staged);
+  showPixels();
   
   animationEnabled = false;
   animationMode = NONE;
 }
 
 void NeoPixelLEDController::update() {
-  if (!animationEnabled) return;
-  
-  unsigned long currentMillis = millis();
-  if (currentMillis - previousUpdateMillis < currentInterval) return;
-  
-  previousUpdateMillis = currentMillis;
+  if (animationStepsDue() == 0) return;
   
+  // Each frame is a function of the step, so steps missed during a stall
+  // are skipped over rather than played late
+  bool oddStep = animationClock.step & 1;
   switch (animationMode) {
     case BLINK1:
-      blinkState = !blinkState;
-      pixels.setPixelColor(0, blinkState ? color1 : 0);
+      if (oddStep) {
+        fillStrip(color1);
+      } else {
+        frameBufferClear(&frame);
+      }
       showPixels();
       break;
       
     case BLINK2:
-      blinkState = !blinkState;
-      pixels.setPixelColor(0, blinkState ? color1 : color2);
+      fillStrip(oddStep ? color2 : color1);
       showPixels();
       break;
       
     case RAINBOW:
-      pixels.setPixelColor(0, pixels.gamma32(pixels.ColorHSV(rainbowHue)));
+      renderRainbow();
+      showPixels();
+      break;
+      
+    case FADE: {
+      uint16_t weight = transitionWeight(&fade, millis());
+      transitionRender(&frame, fadeFrom, color1[0], color1[1], color1[2], weight);
       showPixels();
-      rainbowHue += 256; // Increment hue
-      if (rainbowHue > 65535) rainbowHue = 0;
+      if (weight >= TRANSITION_WEIGHT_MAX) stopAnimation();  // Holds the target
       break;
+    }
       
     default:
       break;
@@ -60,48 +77,58 @@ void NeoPixelLEDController::turnOn() {
 
 void NeoPixelLEDController::turnOff() {
   stopAnimation();
-  pixels.clear();
+  frameBufferClear(&frame);
   showPixels();
 }
 
 void NeoPixelLEDController::setColor(uint8_t r, uint8_t g, uint8_t b) {
   stopAnimation();
-  pixels.setPixelColor(0, createColor(r, g, b));
+  frameBufferFill(&frame, 0, frame.count, r, g, b);
   showPixels();
 }
 
 void NeoPixelLEDController::startBlink(uint8_t r, uint8_t g, uint8_t b, long interval) {
-  currentInterval = interval;
-  color1 = createColor(r, g, b);
+  color1[0] = r; color1[1] = g; color1[2] = b;
   animationMode = BLINK1;
-  animationEnabled = true;
-  blinkState = false;
-  previousUpdateMillis = millis();
+  startAnimationClock(interval);
   
-  pixels.setPixelColor(0, 0); // Start with LED off
+  frameBufferClear(&frame); // Start with the strip off
   showPixels();
 }
 
 void NeoPixelLEDController::startBlink2(uint8_t r1, uint8_t g1, uint8_t b1, 
                                        uint8_t r2, uint8_t g2, uint8_t b2, long interval) {
-  currentInterval = interval;
-  color1 = createColor(r1, g1, b1);
-  color2 = createColor(r2, g2, b2);
+  color1[0] = r1; color1[1] = g1; color1[2] = b1;
+  color2[0] = r2; color2[1] = g2; color2[2] = b2;
   animationMode = BLINK2;
-  animationEnabled = true;
-  blinkState = false;
-  previousUpdateMillis = millis();
+  startAnimationClock(interval);
   
-  pixels.setPixelColor(0, color1); // Start with first color
+  fillStrip(color1); // Start with first color
   showPixels();
 }
 
 void NeoPixelLEDController::startRainbow(long interval) {
-  currentInterval = interval;
   animationMode = RAINBOW;
-  animationEnabled = true;
-  rainbowHue = 0;
-  previousUpdateMillis = millis();
+  startAnimationClock(interval);
+  
+  renderRainbow(); // Step 0: hue 0 at the first pixel
+  showPixels();
+}
+
+void NeoPixelLEDController::startFade(uint8_t r, uint8_t g, uint8_t b, uint16_t duration, uint8_t curve) {
+  // Start from whatever the strip shows now, including a running effect
+  // or a PIXELS pattern; every pixel fades to the same target
+  memcpy(fadeFrom, frame.data, (size_t)frame.count * 3);
+  color1[0] = r; color1[1] = g; color1[2] = b;
+  transitionStart(&fade, millis(), duration, curve);
+  animationMode = FADE;
+  startAnimationClock(TRANSITION_FRAME_MS);
+  
+  if (duration == 0) {
+    stopAnimation();
+    frameBufferFill(&frame, 0, frame.count, r, g, b);
+    showPixels();
+  }
 }
 
 void NeoPixelLEDController::stopAnimation() {
@@ -109,10 +136,49 @@ void NeoPixelLEDController::stopAnimation() {
   animationMode = NONE;
 }
 
-void NeoPixelLEDController::showPixels() {
-  pixels.show();
+void NeoPixelLEDController::setPixel(uint16_t index, uint8_t r, uint8_t g, uint8_t b) {
+  frameStageSet(&staged, index, r, g, b);
+}
+
+void NeoPixelLEDController::fillPixels(uint16_t first, uint16_t count, uint8_t r, uint8_t g, uint8_t b) {
+  stopAnimation();
+  frameBufferFill(&frame, first, count, r, g, b);
+  showPixels();
+}
+
+void NeoPixelLEDController::show() {
+  stopAnimation();
+  frameStageCommit(&staged, &frame);
+  showPixels();
+}
+
+void NeoPixelLEDController::discardPixels() {
+  frameStageDiscard(&staged);
 }
 
-uint32_t NeoPixelLEDController::createColor(uint8_t r, uint8_t g, uint8_t b) {
-  return pixels.Color(r, g, b);
+void NeoPixelLEDController::fillStrip(const uint8_t* color) {
+  frameBufferFill(&frame, 0, frame.count, color[0], color[1], color[2]);
+}
+
+void NeoPixelLEDController::renderRainbow() {
+  // One full hue turn spread along the strip, rotated 256 hue units per step
+  colorRainbowFill(&frame, (uint16_t)(animationClock.step * 256));
+}
+
+void NeoPixelLEDController::showPixels() {
+  // show() holds interrupts off for ~30 us per pixel, long enough for serial
+  // RX to overrun, so an unchanged frame is never latched again
+  uint16_t first, end;
+  if (!frameBufferTakeDirty(&frame, &first, &end)) {
+    showSkipCount++;
+    return;
+  }
+  
+  // Copy just the pixels that changed, then latch the strip in one show()
+  for (uint16_t i = first; i < end; i++) {
+    const uint8_t* pixel = frameBufferPixel(&frame, i);
+    pixels.setPixelColor(i, pixel[0], pixel[1], pixel[2]);
+  }
+  pixels.show();
+  showCount++;
 }
\ No newline at end of file
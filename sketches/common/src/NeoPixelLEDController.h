@@ -2,15 +2,20 @@
 #define NEOPIXEL_LED_CONTROLLER_H
 
 #include "LEDController.h"
+#include "FrameBuffer.h"
+#include "Transition.h"
 #include <Adafruit_NeoPixel.h>
 
 /**
  * NeoPixel LED Controller for RGB LEDs (XIAO RP2040, ESP32 with WS2812, etc.)
- * Supports full RGB color control, animations, and rainbow effects
+ * Supports full RGB color control, animations, and rainbow effects.
+ * Every effect renders the whole strip into a framebuffer, which is pushed
+ * to the LEDs with a single show() per frame.
  */
 class NeoPixelLEDController : public LEDController {
 public:
   NeoPixelLEDController(int dataPin, int powerPin = -1, int ledCount = 1, int brightness = 128);
+  ~NeoPixelLEDController();
   
   // Lifecycle
   void initialize() override;
@@ -28,8 +33,16 @@ public:
   void startBlink2(uint8_t r1, uint8_t g1, uint8_t b1, 
                   uint8_t r2, uint8_t g2, uint8_t b2, long interval) override;
   void startRainbow(long interval) override;
+  void startFade(uint8_t r, uint8_t g, uint8_t b, uint16_t duration, uint8_t curve) override;
   void stopAnimation() override;
   
+  // Pixel access
+  uint16_t getPixelCount() const override { return pixels.numPixels(); }
+  void setPixel(uint16_t index, uint8_t r, uint8_t g, uint8_t b) override;
+  void show() override;
+  void discardPixels() override;
+  void fillPixels(uint16_t first, uint16_t count, uint8_t r, uint8_t g, uint8_t b) override;
+  
   // Capabilities
   bool supportsColor() const override { return true; }
   bool supportsRainbow() const override { return true; }
@@ -38,19 +51,22 @@ public:
 
 private:
   Adafruit_NeoPixel pixels;
+  FrameBuffer frame;
+  FrameStage staged;  // PIXELS payload until the command is accepted
+  uint8_t* fadeFrom;  // Strip snapshot a fade starts from, 3 bytes per pixel
   int powerPin;
   
-  enum AnimationMode { NONE, BLINK1, BLINK2, RAINBOW };
+  enum AnimationMode { NONE, BLINK1, BLINK2, RAINBOW, FADE };
   AnimationMode animationMode;
   
-  // Animation state
-  uint32_t color1, color2;
-  bool blinkState;
-  int rainbowHue;
+  // Animation state (the phase is animationClock.step)
+  uint8_t color1[3], color2[3];  // Blink colors; color1 is also the fade target
+  Transition fade;
   
   // Helper methods
+  void fillStrip(const uint8_t* color);
+  void renderRainbow();
   void showPixels();
-  uint32_t createColor(uint8_t r, uint8_t g, uint8_t b);
 };
 
 #endif // NEOPIXEL_LED_CONTROLLER_H
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "ReliableLink.h"
+
+void reliableLinkInit(ReliableLink* link, ReliableSlot* slots, uint8_t* statuses, uint8_t size) {
+    link->slots = slots;
+    link->statuses = statuses;
+    link->mask = (uint8_t)(size - 1);
+    link->naks = 0;
+    link->duplicates = 0;
+    reliableLinkSet(link, false);
+}
+
+void reliableLinkSet(ReliableLink* link, bool enabled) {
+    link->enabled = enabled;
+    link->expected = 0;
+    link->gap = false;
+    link->nakSent = false;
+    for (uint16_t i = 0; i <= link->mask; i++) {
+        link->slots[i].held = false;
+        link->statuses[i] = PARSE_OK;
+    }
+}
+
+uint8_t reliableLinkWindow(const ReliableLink* link) {
+    return (uint8_t)(link->mask + 1);
+}
+
+ReliableVerdict reliableLinkReceive(ReliableLink* link, uint8_t sequence, const ParsedCommand* parsed) {
+    if (parsed->error == PARSE_BAD_FRAME) {
+        link->gap = true;  // Its sequence number cannot be trusted
+        return RELIABLE_DROPPED;
+    }
+
+    uint8_t ahead = (uint8_t)(sequence - link->expected);
+    if (ahead == 0) {
+        link->statuses[sequence & link->mask] = (uint8_t)parsed->error;
+        link->expected++;
+        link->gap = false;
+        link->nakSent = false;
+        return RELIABLE_RUN;
+    }
+
+    if (ahead <= link->mask) {
+        ReliableSlot* slot = &link->slots[sequence & link->mask];
+        slot->command = *parsed;
+        slot->held = true;
+        link->gap = true;
+        return RELIABLE_HELD;
+    }
+
+    // Behind by up to one window: the host missed our acknowledgement
+    if ((uint8_t)(link->expected - sequence) <= link->mask + 1) {
+        link->duplicates++;
+        return RELIABLE_DUPLICATE;
+    }
+
+    return RELIABLE_DROPPED;
+}
+
+bool reliableLinkNextHeld(ReliableLink* link, ParsedCommand* parsed, uint8_t* sequence) {
+    ReliableSlot* slot = &link->slots[link->expected & link->mask];
+    if (slot->held) {
+        slot->held = false;
+        *parsed = slot->command;
+        *sequence = link->expected;
+        link->statuses[link->expected & link->mask] = (uint8_t)parsed->error;
+        link->expected++;
+        return true;
+    }
+
+    // Frames still held further on mean another gap
+    for (uint16_t i = 0; i <= link->mask; i++) {
+        if (link->slots[i].held) {
+            link->gap = true;
+            break;
+        }
+    }
+    return false;
+}
+
+ParseError reliableLinkStatus(const ReliableLink* link, uint8_t sequence) {
+    return (ParseError)link->statuses[sequence & link->mask];
+}
+
+bool reliableLinkTakeNak(ReliableLink* link, uint8_t* sequence) {
+    if (!link->enabled || !link->gap || link->nakSent) return false;
+
+    link->nakSent = true;
+    link->naks++;
+    *sequence = link->expected;
+    return true;
+}
+
+void writeReliableWindow(ResponseWriter* writer, const ReliableLink* link) {
+    responseAppendLiteral(writer, ",window=");
+    responseAppendInt(writer, reliableLinkWindow(link));
+}
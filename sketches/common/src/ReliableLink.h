@@ -0,0 +1,67 @@
+#ifndef RELIABLE_LINK_H
+#define RELIABLE_LINK_H
+
+#include "CommandProcessor.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Reliable mode (RELIABLE,1): every binary frame carries a sequence number
+// and is acknowledged by it. A frame that fails its CRC, or that arrives
+// after a gap, draws one NAK naming the first missing sequence number.
+// Frames past the gap are held (up to the window size) and run as soon as
+// the gap is filled, so the host resends only what was lost. A resent frame
+// that already arrived is acknowledged again but never run twice.
+typedef enum {
+    RELIABLE_RUN,        // Next in sequence: run it, then any frames it releases
+    RELIABLE_HELD,       // Past a gap: held until the gap is filled
+    RELIABLE_DUPLICATE,  // Already received: acknowledge again with its status
+    RELIABLE_DROPPED     // Corrupt or outside the window
+} ReliableVerdict;
+
+typedef struct {
+    ParsedCommand command;
+    bool held;
+} ReliableSlot;
+
+// Window state over caller-provided storage: one slot and one status byte
+// per window position. The window must be a power of two, at most 128.
+typedef struct {
+    bool enabled;
+    uint8_t expected;       // Sequence number of the next frame to run
+    uint8_t mask;           // Window size - 1
+    ReliableSlot* slots;    // Held frames, by sequence & mask
+    uint8_t* statuses;      // ParseError of recently run frames, by sequence & mask
+    bool gap;               // A frame is missing
+    bool nakSent;           // This gap has been reported
+    uint16_t naks;
+    uint16_t duplicates;
+} ReliableLink;
+
+void reliableLinkInit(ReliableLink* link, ReliableSlot* slots, uint8_t* statuses, uint8_t size);
+
+// Enabling or disabling restarts the sequence at 0 and forgets held frames
+void reliableLinkSet(ReliableLink* link, bool enabled);
+uint8_t reliableLinkWindow(const ReliableLink* link);
+
+// Classify a decoded frame (parsed->error == PARSE_BAD_FRAME for a corrupt one)
+ReliableVerdict reliableLinkReceive(ReliableLink* link, uint8_t sequence, const ParsedCommand* parsed);
+
+// After RELIABLE_RUN: the next held frame that is now in sequence, if any
+bool reliableLinkNextHeld(ReliableLink* link, ParsedCommand* parsed, uint8_t* sequence);
+
+// Status recorded for a duplicate's sequence number
+ParseError reliableLinkStatus(const ReliableLink* link, uint8_t sequence);
+
+// Sequence number to NAK, at most once per gap; false when none is due
+bool reliableLinkTakeNak(ReliableLink* link, uint8_t* sequence);
+
+// Append ,window=<n> to an ACCEPTED,RELIABLE line
+void writeReliableWindow(ResponseWriter* writer, const ReliableLink* link);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RELIABLE_LINK_H
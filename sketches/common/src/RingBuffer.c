@@ -0,0 +1,36 @@
+#include "RingBuffer.h"
+
+void ringBufferInit(RingBuffer* ring, uint8_t* storage, uint16_t size) {
+    ring->data = storage;
+    ring->mask = (uint16_t)(size - 1);
+    ringBufferClear(ring);
+}
+
+void ringBufferClear(RingBuffer* ring) {
+    ring->head = 0;
+    ring->tail = 0;
+}
+
+uint16_t ringBufferCount(const RingBuffer* ring) {
+    return (uint16_t)(ring->head - ring->tail);
+}
+
+uint16_t ringBufferFree(const RingBuffer* ring) {
+    return (uint16_t)(ring->mask + 1 - ringBufferCount(ring));
+}
+
+bool ringBufferPush(RingBuffer* ring, uint8_t byte) {
+    if (ringBufferCount(ring) > ring->mask) return false;
+
+    ring->data[ring->head & ring->mask] = byte;
+    ring->head++;
+    return true;
+}
+
+bool ringBufferPop(RingBuffer* ring, uint8_t* byte) {
+    if (ring->head == ring->tail) return false;
+
+    *byte = ring->data[ring->tail & ring->mask];
+    ring->tail++;
+    return true;
+}
@@ -0,0 +1,38 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Byte ring over caller-provided static storage. The size must be a power
+// of two: head and tail run freely and are masked on access, so the fill
+// level is head - tail and no modulo or heap is ever involved.
+#define RING_BUFFER_IS_POWER_OF_TWO(n) ((n) >= 2 && ((n) & ((n) - 1)) == 0)
+
+typedef struct {
+    uint8_t* data;
+    uint16_t mask;           // size - 1
+    volatile uint16_t head;  // Next write position
+    volatile uint16_t tail;  // Next read position
+} RingBuffer;
+
+// size must satisfy RING_BUFFER_IS_POWER_OF_TWO and be at most 32768
+void ringBufferInit(RingBuffer* ring, uint8_t* storage, uint16_t size);
+void ringBufferClear(RingBuffer* ring);
+
+uint16_t ringBufferCount(const RingBuffer* ring);
+uint16_t ringBufferFree(const RingBuffer* ring);
+
+// false when full (byte not stored) / empty (nothing read)
+bool ringBufferPush(RingBuffer* ring, uint8_t byte);
+bool ringBufferPop(RingBuffer* ring, uint8_t* byte);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RING_BUFFER_H
@@ -4,107 +4,421 @@ extern "C" {
   #include "CommandProcessor.h"
 }
 
-SerialCommandHandler::SerialCommandHandler(LEDController* ledController) 
-  : led(ledController), commandReady(false) {
+SerialCommandHandler::SerialCommandHandler(LEDController* ledController, Transport* transport)
+  : led(ledController), link(transport), commandsPerLoop(COMMANDS_PER_LOOP), echoMode(ECHO_FULL),
+    baudRate(SERIAL_DEFAULT_BAUD), fallbackBaudRate(SERIAL_DEFAULT_BAUD), requestedBaudRate(0) {
+  baudConfirmReset(&baudConfirm);
+  ringBufferInit(&rx, rxStorage, sizeof(rxStorage));
+  ringBufferInit(&tx, txStorage, sizeof(txStorage));
+  txHighWater = 0;
+  txStalls = 0;
+  commandQueueInit(&queue, queueStorage, COMMAND_QUEUE_SIZE);
+  commandStreamReset(&stream);
+  frameDecoderReset(&frame);
+  quietModeSet(&quiet, false);
+  flowControlSet(&flow, false);
+  reliableLinkInit(&reliable, reliableSlots, reliableStatuses, RELIABLE_WINDOW);
 }
 
 void SerialCommandHandler::initialize(long baudRate) {
-  // Serial already initialized in universalSetup
-  serialBuffer.reserve(64);  // Pre-allocate buffer space
+  link->begin(baudRate);
+  this->baudRate = baudRate;
+  fallbackBaudRate = baudRate;
+  requestedBaudRate = 0;
+  baudConfirmReset(&baudConfirm);
+  
+  ringBufferClear(&rx);
+  ringBufferClear(&tx);
+  txHighWater = 0;
+  txStalls = 0;
+  commandQueueClear(&queue);
+  commandStreamReset(&stream);
+  frameDecoderReset(&frame);
+  quietModeSet(&quiet, false);
+  flowControlSet(&flow, false);
+  reliableLinkInit(&reliable, reliableSlots, reliableStatuses, RELIABLE_WINDOW);
+}
+
+void SerialCommandHandler::setCommandsPerLoop(uint8_t count) {
+  commandsPerLoop = count > 0 ? count : 1;
 }
 
 void SerialCommandHandler::handleSerial() {
-  while (Serial.available() > 0) {
-    char c = Serial.read();
-    if (c == '\n') {
-      if (serialBuffer.length() > 0) {
-        serialBuffer.trim();
-        commandReady = true;
-        return; // Process one command per loop cycle
+  // Nothing valid arrived at the negotiated rate: return to the last working one
+  if (baudConfirmExpired(&baudConfirm, millis(), SERIAL_BAUD_CONFIRM_MS)) {
+    beginTransport(fallbackBaudRate);
+  }
+  
+  // Bytes held back while the queue was full come first
+  decodeInput();
+  
+  // Drain everything the transport has buffered. Decoding keeps pace with the
+  // ring, so on a hardware UART input is never left in its FIFO; when the
+  // queue is full completed commands are dropped and reported, not the raw
+  // bytes. Over native USB reading stops instead and the host waits.
+  while (!inputPaused() && link->available() > 0) {
+    while (link->available() > 0 && ringBufferFree(&rx) > 0) {
+      ringBufferPush(&rx, (uint8_t)link->read());
+    }
+    decodeInput();
+  }
+}
+
+bool SerialCommandHandler::inputPaused() const {
+  return SERIAL_RX_BACKPRESSURE && commandQueueFull(&queue);
+}
+
+void SerialCommandHandler::decodeInput() {
+  uint8_t c;
+  while (!inputPaused() && ringBufferPop(&rx, &c)) {
+    if (c == FRAME_DELIMITER || frame.active) {
+      if (frameDecoderFeed(&frame, c)) {
+        if (reliable.enabled) {
+          receiveReliableFrame();
+          continue;
+        }
+        ParsedCommand cmd;
+        decodeCommandFrame(frame.payload, frame.error ? 0 : frame.length, &cmd);
+        commandQueuePushFrame(&queue, &cmd);
+      } else {
+        commandStreamReset(&stream);  // A frame abandons any partial text line
+        // In reliable mode an empty frame means a delimiter was lost or
+        // corrupted; the second one opens the next frame so the link resyncs
+        if (reliable.enabled && c == FRAME_DELIMITER && !frame.active) {
+          frameDecoderReset(&frame);
+          frame.active = true;
+        }
       }
-    } else {
-      // Add all non-newline characters to buffer (including \r)
-      serialBuffer += c;
-      if (serialBuffer.length() > 60) { // Prevent buffer overflow
-        serialBuffer = "";
-        sendRejected("BUFFER_OVERFLOW", "command too long");
+      continue;
+    }
+    
+    // Bytes are decoded as they arrive; a command is ready at its newline or separator
+    if (commandStreamFeed(&stream, c)) {
+      // A batch is always answered, even when the item ending it is dropped
+      if (!commandQueuePushStream(&queue, &stream) && commandQueueRehomeSummary(&queue, &stream)) {
+        sendBatchSummary(stream.batch, stream.command);
       }
+    } else if (stream.unitReady) {
+      applyPayloadUnit();
     }
   }
 }
 
 void SerialCommandHandler::processCommands() {
-  if (commandReady) {
-    processCommand(serialBuffer);
-    serialBuffer = "";
-    commandReady = false;
+  for (uint8_t i = 0; i < commandsPerLoop; i++) {
+    const QueuedCommand* entry = commandQueueFront(&queue);
+    if (!entry) break;
+    runQueued(*entry);
+    bool lineDone = !entry->inBatch || entry->lineComplete;
+    commandQueueDrop(&queue);
+    flowControlRelease(&flow, 1);
+    
+    // A rate change waits until its line has been acknowledged
+    if (requestedBaudRate != 0 && lineDone) {
+      applyBaudRate();
+    }
+  }
+  
+  // Dropped commands are reported explicitly, once per loop
+  uint16_t dropped = commandQueueTakeOverflow(&queue);
+  if (dropped > 0) {
+    ResponseWriter writer;
+    responseWriterInit(&writer, txLine, sizeof(txLine));
+    writeQueueOverflow(&writer, dropped);
+    sendLine(writer);
+    flowControlRelease(&flow, dropped);  // Their credits were spent too
+  }
+  
+  // Freed slots go back to the host after this loop's responses
+  uint16_t credits = flowControlTake(&flow, COMMAND_QUEUE_SIZE - commandQueueCount(&queue));
+  if (credits > 0) {
+    ResponseWriter writer;
+    responseWriterInit(&writer, txLine, sizeof(txLine));
+    writeCredit(&writer, credits);
+    sendLine(writer);
   }
 }
 
-void SerialCommandHandler::processCommand(const String& cmd) {
-  // Use CommandProcessor for parsing and response generation
-  CommandResponse response;
-  ::processCommand(cmd.c_str(), &response);  // Call global C function
+void SerialCommandHandler::applyPayloadUnit() {
+  // Payload units bypass the queue, so whatever was queued ahead of this
+  // command has to take effect before its first unit does
+  if (stream.unitCount == 1) {
+    runQueuedAhead();
+    led->discardPixels();  // Left over from a line that never ran (overflow, abandoned)
+  }
   
-  // Execute LED actions based on successful parsing
-  if (response.result == COMMAND_ACCEPTED) {
-    if (cmd == "ON") {
-      led->turnOn();
+  const uint8_t* unit = stream.unit;
+  if (stream.command.opcode == OPCODE_PIXELS) {
+    long index = stream.command.args[0] + stream.unitCount - 1;
+    if (index < led->getPixelCount()) {
+      led->setPixel((uint16_t)index, unit[0], unit[1], unit[2]);  // Shown only if PIXELS is accepted
     }
-    else if (cmd == "OFF") {
+  }
+}
+
+void SerialCommandHandler::runQueuedAhead() {
+  // A rate change stays pending until processCommands() finishes a line:
+  // switching here would cut off the payload being received
+  const QueuedCommand* entry;
+  while ((entry = commandQueueFront(&queue)) != NULL) {
+    runQueued(*entry);
+    commandQueueDrop(&queue);
+    flowControlRelease(&flow, 1);
+  }
+}
+
+void SerialCommandHandler::runQueued(const QueuedCommand& entry) {
+  // Any valid command decoded at a freshly negotiated rate confirms it
+  // (hosts send PING); entries queued before the switch do not
+  baudConfirmQueued(&baudConfirm, entry.command.error == PARSE_OK);
+  
+  // A rejected PIXELS (bad hex, partial unit, too long) leaves the strip
+  // and any running animation as they were
+  if (entry.command.opcode == OPCODE_PIXELS && entry.command.error != PARSE_OK) {
+    led->discardPixels();
+  }
+  
+  if (entry.source == QUEUED_FRAME) {
+    processFrame(entry.command);
+  } else if (entry.inBatch) {
+    processBatchItem(entry);
+  } else {
+    processCommand(entry.command, entry.verb);
+  }
+}
+
+void SerialCommandHandler::processCommand(const ParsedCommand& cmd, const char* echo) {
+  // The decoded command drives both the LED and the response, no rescan
+  if (cmd.error == PARSE_OK) {
+    executeCommand(cmd);
+  }
+  
+  // Quiet mode drops the ACCEPTED line entirely; rejects gain a sequence tag
+  ParsedCommand reply = cmd;
+  if (!quietModeFilter(&quiet, &reply, cmd.error == PARSE_OK)) return;
+  
+  ResponseWriter writer;
+  responseWriterInit(&writer, txLine, sizeof(txLine));
+  writeResponse(&writer, echo, &reply, echoMode);
+  if (cmd.opcode == OPCODE_STATS && cmd.error == PARSE_OK) {
+    SerialStats stats = { txHighWater, (uint16_t)sizeof(txStorage), txStalls, PAYLOAD_MAX_BYTES,
+                          reliable.naks, reliable.duplicates, led->getShowCount(), led->getShowSkipCount() };
+    writeStats(&writer, &stats);
+  } else if (cmd.opcode == OPCODE_RELIABLE && cmd.error == PARSE_OK) {
+    writeReliableWindow(&writer, &reliable);
+  } else if (cmd.opcode == OPCODE_CAPS && cmd.error == PARSE_OK) {
+    DeviceCaps caps = { led->getLEDType(), led->getPixelCount(), (uint16_t)sizeof(rxStorage), SERIAL_BAUD_MAX,
+                        capsVerbMask(led->supportsColor(), led->supportsBlink2(), led->supportsRainbow()) };
+    writeCaps(&writer, &caps);
+  }
+  sendLine(writer);
+}
+
+void SerialCommandHandler::processBatchItem(const QueuedCommand& entry) {
+  // Items run in order; one summary line answers the whole batch
+  if (entry.command.error == PARSE_OK) {
+    executeCommand(entry.command);
+  }
+  
+  if (entry.lineComplete) {
+    sendBatchSummary(entry.batch, entry.command);
+  }
+}
+
+void SerialCommandHandler::sendBatchSummary(const BatchStatus& batch, const ParsedCommand& cmd) {
+  ParsedCommand reply = cmd;
+  if (!quietModeFilter(&quiet, &reply, batchAccepted(&batch))) return;
+  
+  ResponseWriter writer;
+  responseWriterInit(&writer, txLine, sizeof(txLine));
+  writeBatchSummary(&writer, &batch, &reply);
+  sendLine(writer);
+}
+
+void SerialCommandHandler::processFrame(const ParsedCommand& cmd) {
+  if (cmd.error == PARSE_OK) {
+    executeCommand(cmd);
+  }
+  
+  // Binary requests get binary responses, built in the same transmit buffer
+  uint8_t* out = reinterpret_cast<uint8_t*>(txLine);
+  queueTx(out, encodeResponseFrame(&cmd, out));
+}
+
+void SerialCommandHandler::receiveReliableFrame() {
+  ParsedCommand cmd;
+  uint8_t sequence = 0;
+  decodeReliableFrame(frame.payload, frame.error ? 0 : frame.length, &sequence, &cmd);
+  
+  switch (reliableLinkReceive(&reliable, sequence, &cmd)) {
+    case RELIABLE_RUN:
+      // Sequenced frames skip the queue (the window bounds them instead);
+      // anything queued before this one still runs first
+      runQueuedAhead();
+      do {
+        runReliableFrame(cmd, sequence);
+      } while (reliable.enabled && reliableLinkNextHeld(&reliable, &cmd, &sequence));
+      break;
+    case RELIABLE_DUPLICATE:
+      cmd.error = reliableLinkStatus(&reliable, sequence);  // Answer as the first time
+      sendReliableResponse(sequence, cmd);
+      break;
+    default:
+      break;
+  }
+  
+  uint8_t missing;
+  if (reliableLinkTakeNak(&reliable, &missing)) {
+    ParsedCommand nak = cmd;
+    nak.opcode = OPCODE_NONE;
+    nak.error = PARSE_BAD_FRAME;
+    sendReliableResponse(missing, nak);
+  }
+  
+  if (requestedBaudRate != 0) {
+    applyBaudRate();
+  }
+}
+
+void SerialCommandHandler::runReliableFrame(const ParsedCommand& cmd, uint8_t sequence) {
+  if (cmd.error == PARSE_OK) {
+    baudConfirmDirect(&baudConfirm);
+    executeCommand(cmd);
+  }
+  sendReliableResponse(sequence, cmd);
+}
+
+void SerialCommandHandler::sendReliableResponse(uint8_t sequence, const ParsedCommand& cmd) {
+  uint8_t* out = reinterpret_cast<uint8_t*>(txLine);
+  queueTx(out, encodeReliableResponseFrame(sequence, &cmd, out));
+}
+
+void SerialCommandHandler::executeCommand(const ParsedCommand& cmd) {
+  const long* a = cmd.args;
+  
+  switch (cmd.opcode) {
+    case OPCODE_ON:
+      led->turnOn();
+      break;
+    case OPCODE_OFF:
       led->turnOff();
+      break;
+    case OPCODE_COLOR:
+      led->setColor(a[0], a[1], a[2]);
+      break;
+    case OPCODE_BLINK1:
+      led->startBlink(a[0], a[1], a[2], a[3]);
+      break;
+    case OPCODE_BLINK2:
+      led->startBlink2(a[0], a[1], a[2], a[3], a[4], a[5], a[6]);
+      break;
+    case OPCODE_RAINBOW:
+      led->startRainbow(a[0]);
+      break;
+    case OPCODE_ECHO:
+      echoMode = a[0] ? ECHO_FULL : ECHO_COMPACT;
+      break;
+    case OPCODE_QUIET:
+      quietModeSet(&quiet, a[0] != 0);
+      break;
+    case OPCODE_STATS:
+      break;  // Counters are appended to the response
+    case OPCODE_BAUD:
+      requestedBaudRate = a[0];
+      break;
+    case OPCODE_PING:
+      break;
+    case OPCODE_FLOW:
+      // Granted at the end of the loop, once this FLOW no longer holds a slot
+      // (a queued one has been dropped; a reliable frame never held one)
+      flowControlSet(&flow, a[0] != 0);
+      break;
+    case OPCODE_PIXELS:
+      led->show();  // Pixels were staged as the payload arrived
+      break;
+    case OPCODE_RELIABLE:
+      reliableLinkSet(&reliable, a[0] != 0);
+      break;
+    case OPCODE_FILL:
+      led->fillPixels(a[0], a[1], a[2], a[3], a[4]);
+      break;
+    case OPCODE_FADE:
+      led->startFade(a[0], a[1], a[2], a[3], a[4]);
+      break;
+    default:
+      break;
+  }
+}
+
+void SerialCommandHandler::sendLine(ResponseWriter& writer) {
+  responseEndLine(&writer);
+  queueTx(reinterpret_cast<const uint8_t*>(writer.buffer), writer.length);
+}
+
+void SerialCommandHandler::queueTx(const uint8_t* data, uint16_t length) {
+  // Only a response burst larger than the ring waits on the transport, and then
+  // just for the bytes it needs (oldest first, so order is kept)
+  if (ringBufferFree(&tx) < length) {
+    txStalls++;
+    uint8_t c;
+    while (ringBufferFree(&tx) < length && ringBufferPop(&tx, &c)) {
+      link->write(&c, 1);
     }
-    else if (cmd.startsWith("COLOR,")) {
-      uint8_t r, g, b;
-      if (parseColorCommand(cmd.c_str(), &r, &g, &b)) {
-        led->setColor(r, g, b);
-      }
-    }
-    else if (cmd.startsWith("BLINK1,")) {
-      uint8_t r, g, b;
-      long interval;
-      if (parseBlink1Command(cmd.c_str(), &r, &g, &b, &interval)) {
-        led->startBlink(r, g, b, interval);
-      }
-    }
-    else if (cmd.startsWith("BLINK2,")) {
-      uint8_t r1, g1, b1, r2, g2, b2;
-      long interval;
-      if (parseBlink2Command(cmd.c_str(), &r1, &g1, &b1, &r2, &g2, &b2, &interval)) {
-        led->startBlink2(r1, g1, b1, r2, g2, b2, interval);
-      }
-    }
-    else if (cmd.startsWith("RAINBOW,")) {
-      long interval;
-      if (parseRainbowCommand(cmd.c_str(), &interval)) {
-        led->startRainbow(interval);
-      }
-    }
   }
   
-  // Send response using CommandProcessor output
-  Serial.println(response.response);
-  Serial.flush();
+  for (uint16_t i = 0; i < length; i++) {
+    ringBufferPush(&tx, data[i]);
+  }
+  
+  uint16_t pending = ringBufferCount(&tx);
+  if (pending > txHighWater) {
+    txHighWater = pending;
+  }
 }
 
-// Parser functions now handled by CommandProcessor.c
-
-void SerialCommandHandler::sendAccepted(const String& command, const String& additional) {
-  sendResponse("ACCEPTED", command, additional);
+bool SerialCommandHandler::idle() const {
+  return ringBufferCount(&rx) == 0 && commandQueueCount(&queue) == 0 && ringBufferCount(&tx) == 0;
 }
 
-void SerialCommandHandler::sendRejected(const String& command, const String& reason) {
-  sendResponse("REJECT", command, reason);
+void SerialCommandHandler::drainTx() {
+  // Write no more than the transport can buffer, so this never blocks
+  uint8_t chunk[32];
+  int room = link->availableForWrite();
+  while (room > 0 && ringBufferCount(&tx) > 0) {
+    uint8_t n = 0;
+    while (n < sizeof(chunk) && n < room && ringBufferPop(&tx, &chunk[n])) {
+      n++;
+    }
+    link->write(chunk, n);
+    room -= n;
+  }
 }
 
-void SerialCommandHandler::sendResponse(const String& status, const String& command, const String& additional) {
-  Serial.print(status);
-  Serial.print(",");
-  Serial.print(command);
-  if (additional.length() > 0) {
-    Serial.print(",");
-    Serial.print(additional);
+void SerialCommandHandler::applyBaudRate() {
+  long rate = requestedBaudRate;
+  requestedBaudRate = 0;
+  if (rate == baudRate) return;
+  
+  // The acknowledgement must leave at the old rate, so this is the one place
+  // the transmit path waits for the transport
+  uint8_t c;
+  while (ringBufferPop(&tx, &c)) {
+    link->write(&c, 1);
   }
-  Serial.println();
-  Serial.flush(); // Ensure immediate transmission
-}
\ No newline at end of file
+  link->flush();
+  
+  fallbackBaudRate = baudRate;
+  beginTransport(rate);
+  baudConfirmStart(&baudConfirm, commandQueueCount(&queue), millis());
+}
+
+void SerialCommandHandler::beginTransport(long rate) {
+  link->end();
+  link->begin(rate);
+  baudRate = rate;
+  
+  // Bytes caught mid-switch are noise at either rate
+  ringBufferClear(&rx);
+  commandStreamReset(&stream);
+  frameDecoderReset(&frame);
+}
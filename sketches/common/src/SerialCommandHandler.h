@@ -3,36 +3,91 @@
 
 #include <Arduino.h>
 #include "LEDController.h"
+#include "Transport.h"
 #include "CommandProcessor.h"
+#include "FrameCodec.h"
+#include "RingBuffer.h"
+#include "CommandQueue.h"
+#include "ReliableLink.h"
+#include "BoardConfig.h"
 
 /**
  * Common serial command handling for all board types
  * Handles non-blocking serial input, command parsing, and response generation
+ * over any Transport (USB CDC, hardware UART, or a host pty)
  */
 class SerialCommandHandler {
 public:
-  SerialCommandHandler(LEDController* ledController);
+  SerialCommandHandler(LEDController* ledController, Transport* transport);
   
-  void initialize(long baudRate = 9600);
+  void initialize(long baudRate = SERIAL_DEFAULT_BAUD);  // Opens the transport at baudRate
   void handleSerial();  // Non-blocking serial input processing
   void processCommands();  // Process complete commands
+  void drainTx();  // Hand queued response bytes to the transport without blocking
+  bool idle() const;  // No input, queued command or response left to handle
+  
+  // Queued commands run per processCommands() call (at least 1)
+  void setCommandsPerLoop(uint8_t count);
 
 private:
   LEDController* led;
+  Transport* link;
   
-  // Non-blocking serial buffer
-  String serialBuffer;
-  bool commandReady;
+  // Statically sized RX ring between the transport's buffer and the decoders
+  uint8_t rxStorage[SERIAL_RX_RING_SIZE];
+  RingBuffer rx;
   
-  // Command processing
-  void processCommand(const String& cmd);
-  void sendResponse(const String& status, const String& command, const String& additional = "");
+  // Incremental decoder (no line buffer); completed items go to the queue
+  CommandStream stream;
+  
+  // Binary frames (opened by a 0x00 delimiter) coexist with text lines
+  FrameDecoder frame;
+  
+  // Decoded commands waiting to run, in arrival order
+  QueuedCommand queueStorage[COMMAND_QUEUE_SIZE];
+  CommandQueue queue;
+  uint8_t commandsPerLoop;
+  FlowControl flow;  // CREDIT grants for queue slots (FLOW,1)
   
-  // CommandProcessor integration (C functions used directly)
+  // Reliable mode (RELIABLE,1): sequenced frames run on arrival, in order
+  ReliableSlot reliableSlots[RELIABLE_WINDOW];
+  uint8_t reliableStatuses[RELIABLE_WINDOW];
+  ReliableLink reliable;
   
-  // Response helpers
-  void sendAccepted(const String& command, const String& additional = "");
-  void sendRejected(const String& command, const String& reason);
+  // Responses are assembled in place, then queued in the TX ring
+  char txLine[RESPONSE_MAX_LENGTH];
+  uint8_t txStorage[SERIAL_TX_RING_SIZE];
+  RingBuffer tx;
+  uint16_t txHighWater;
+  uint16_t txStalls;
+  ResponseEcho echoMode;
+  QuietMode quiet;
+  
+  // Baud rate negotiation: BAUD switches once its acknowledgement is sent;
+  // the new rate is kept only if a valid command arrives at it in time
+  long baudRate;
+  long fallbackBaudRate;
+  long requestedBaudRate;  // 0 = no switch pending
+  BaudConfirm baudConfirm;
+  
+  // Command processing
+  void decodeInput();
+  bool inputPaused() const;  // Queue full on a port that can push back
+  void runQueued(const QueuedCommand& entry);
+  void runQueuedAhead();
+  void applyPayloadUnit();
+  void processCommand(const ParsedCommand& cmd, const char* echo);
+  void processBatchItem(const QueuedCommand& entry);
+  void sendBatchSummary(const BatchStatus& batch, const ParsedCommand& cmd);
+  void processFrame(const ParsedCommand& cmd);
+  void receiveReliableFrame();
+  void runReliableFrame(const ParsedCommand& cmd, uint8_t sequence);
+  void sendReliableResponse(uint8_t sequence, const ParsedCommand& cmd);
+  void executeCommand(const ParsedCommand& cmd);
+  void sendLine(ResponseWriter& writer);
+  void queueTx(const uint8_t* data, uint16_t length);
+  void applyBaudRate();
+  void beginTransport(long rate);
 };
 
 #endif // SERIAL_COMMAND_HANDLER_H
\ No newline at end of file
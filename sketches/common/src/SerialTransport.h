@@ -0,0 +1,32 @@
+#ifndef SERIAL_TRANSPORT_H
+#define SERIAL_TRANSPORT_H
+
+#include "Transport.h"
+
+/**
+ * Transport over an Arduino serial port object (Serial, Serial1, ...)
+ * A template because each core has its own port class (SerialUSB, UART,
+ * HardwareSerial); calls compile to direct, non-virtual port calls.
+ *
+ *   static SerialTransport<decltype(Serial1)> uart(Serial1);
+ */
+template <typename Port>
+class SerialTransport : public Transport {
+public:
+  explicit SerialTransport(Port& port) : port(port) {}
+
+  void begin(long baudRate) override { port.begin(baudRate); }
+  void end() override { port.end(); }
+
+  int available() override { return port.available(); }
+  int read() override { return port.read(); }
+
+  int availableForWrite() override { return port.availableForWrite(); }
+  size_t write(const uint8_t* data, size_t length) override { return port.write(data, length); }
+  void flush() override { port.flush(); }
+
+private:
+  Port& port;
+};
+
+#endif // SERIAL_TRANSPORT_H
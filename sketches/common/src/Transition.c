@@ -0,0 +1,69 @@
+#include "Transition.h"
+
+#if defined(__AVR__)
+  #include <avr/pgmspace.h>
+  #define EASE_READ(address) pgm_read_word(address)
+#else
+  // Other cores keep const data in flash without special access
+  #ifndef PROGMEM
+    #define PROGMEM
+  #endif
+  #define EASE_READ(address) (*(address))
+#endif
+
+// Each curve is sampled at 33 points (t = i / 32) in Q8 and interpolated
+// linearly in between
+#define EASE_SEGMENTS 32
+#define EASE_SEGMENT_SHIFT 11  // 16-bit progress / 32 segments
+
+#define EASE_LINEAR_AT(i)  ((i) * 8)
+#define EASE_IN_AT(i)      ((256L * (i) * (i) + 512) / 1024)
+#define EASE_OUT_AT(i)     (256 - EASE_IN_AT(32 - (i)))
+#define EASE_IN_OUT_AT(i)  ((256L * (96L * (i) * (i) - 2L * (i) * (i) * (i)) + 16384) / 32768)
+
+#define EASE_ROW4(CURVE, i)  CURVE(i), CURVE((i) + 1), CURVE((i) + 2), CURVE((i) + 3)
+#define EASE_ROW32(CURVE)    EASE_ROW4(CURVE, 0), EASE_ROW4(CURVE, 4), EASE_ROW4(CURVE, 8), \
+                             EASE_ROW4(CURVE, 12), EASE_ROW4(CURVE, 16), EASE_ROW4(CURVE, 20), \
+                             EASE_ROW4(CURVE, 24), EASE_ROW4(CURVE, 28)
+#define EASE_CURVE(CURVE)    { EASE_ROW32(CURVE), CURVE(32) }
+
+static const uint16_t EASE_TABLE[EASE_CURVE_COUNT][EASE_SEGMENTS + 1] PROGMEM = {
+    EASE_CURVE(EASE_LINEAR_AT),
+    EASE_CURVE(EASE_IN_AT),
+    EASE_CURVE(EASE_OUT_AT),
+    EASE_CURVE(EASE_IN_OUT_AT)
+};
+
+void transitionStart(Transition* transition, uint32_t now, uint16_t duration, uint8_t curve) {
+    transition->start = now;
+    transition->duration = duration;
+    transition->curve = curve < EASE_CURVE_COUNT ? curve : EASE_LINEAR;
+}
+
+uint16_t transitionWeight(const Transition* transition, uint32_t now) {
+    uint32_t elapsed = now - transition->start;
+    if (elapsed >= transition->duration) return TRANSITION_WEIGHT_MAX;
+
+    // Progress in 0.16 fixed point (elapsed < duration <= 65535, no overflow)
+    uint32_t progress = (elapsed << 16) / transition->duration;
+    uint8_t segment = (uint8_t)(progress >> EASE_SEGMENT_SHIFT);
+    uint16_t fraction = (uint16_t)(progress & ((1U << EASE_SEGMENT_SHIFT) - 1));
+
+    const uint16_t* curve = EASE_TABLE[transition->curve];
+    uint16_t low = EASE_READ(&curve[segment]);
+    uint16_t high = EASE_READ(&curve[segment + 1]);
+    return (uint16_t)(low + (((uint32_t)(high - low) * fraction) >> EASE_SEGMENT_SHIFT));
+}
+
+uint8_t transitionBlendChannel(uint8_t from, uint8_t to, uint16_t weight) {
+    return (uint8_t)(((uint16_t)from * (TRANSITION_WEIGHT_MAX - weight) + (uint16_t)to * weight) >> 8);
+}
+
+void transitionRender(FrameBuffer* fb, const uint8_t* from, uint8_t r, uint8_t g, uint8_t b, uint16_t weight) {
+    for (uint16_t i = 0; i < fb->count; i++, from += 3) {
+        frameBufferSet(fb, i,
+                       transitionBlendChannel(from[0], r, weight),
+                       transitionBlendChannel(from[1], g, weight),
+                       transitionBlendChannel(from[2], b, weight));
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef TRANSITION_H
+#define TRANSITION_H
+
+#include "FrameBuffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Crossfade engine for FADE. A transition blends a snapshot of the strip
+// towards a target color over a duration. Progress is computed from
+// elapsed time in fixed point, shaped by an easing curve read from a
+// compiler-generated lookup table, and applied to every pixel, so one
+// command replaces a stream of COLOR steps.
+
+// Milliseconds between rendered fade frames (100 fps); frames in which no
+// pixel changes are not shown (see FrameBuffer)
+#ifndef TRANSITION_FRAME_MS
+  #define TRANSITION_FRAME_MS 10
+#endif
+
+// Wire values of the FADE easing argument
+typedef enum {
+    EASE_LINEAR = 0,
+    EASE_IN,         // Quadratic: starts slow
+    EASE_OUT,        // Quadratic: ends slow
+    EASE_IN_OUT,     // Smoothstep: slow at both ends
+    EASE_CURVE_COUNT
+} EaseCurve;
+
+#define TRANSITION_WEIGHT_MAX 256  // Weight of a finished transition (Q8)
+
+typedef struct {
+    uint32_t start;     // millis() when the transition began
+    uint16_t duration;  // Milliseconds; 0 finishes at once
+    uint8_t curve;      // EaseCurve
+} Transition;
+
+void transitionStart(Transition* transition, uint32_t now, uint16_t duration, uint8_t curve);
+
+// Eased weight of the target at time now, 0 to TRANSITION_WEIGHT_MAX
+uint16_t transitionWeight(const Transition* transition, uint32_t now);
+
+// Blend one channel: from at weight 0, to at TRANSITION_WEIGHT_MAX
+uint8_t transitionBlendChannel(uint8_t from, uint8_t to, uint16_t weight);
+
+// Render every pixel of the strip as its snapshot (from, fb->count * 3
+// bytes) blended towards the target color
+void transitionRender(FrameBuffer* fb, const uint8_t* from, uint8_t r, uint8_t g, uint8_t b, uint16_t weight);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TRANSITION_H
@@ -0,0 +1,30 @@
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Abstract byte link between SerialCommandHandler and the host
+ * Implementations: SerialTransport (Serial, Serial1, ...) on the boards,
+ * PosixTransport (stdin/stdout or a pty) in sketches/common/host
+ */
+class Transport {
+public:
+  virtual ~Transport() {}
+
+  // === Lifecycle ===
+  virtual void begin(long baudRate) = 0;  // Rate is ignored where it has no meaning
+  virtual void end() = 0;
+
+  // === Receive (non-blocking) ===
+  virtual int available() = 0;  // Bytes ready to read
+  virtual int read() = 0;       // Next byte, or -1 when none is ready
+
+  // === Transmit ===
+  virtual int availableForWrite() = 0;  // Bytes write() takes without blocking
+  virtual size_t write(const uint8_t* data, size_t length) = 0;
+  virtual void flush() = 0;  // Wait until written bytes are on the wire (rate changes only)
+};
+
+#endif // TRANSPORT_H
@@ -4,18 +4,23 @@
 SerialCommandHandler* commandHandler = nullptr;
 LEDController* ledController = nullptr;
 
+// Default transport: primary Serial (USB CDC on RP2040 and UNO R4)
+__attribute__((weak)) Transport* createTransport() {
+  static SerialTransport<decltype(Serial)> primary(Serial);
+  return &primary;
+}
+
 void universalSetup() {
-  // Initialize serial communication first
-  Serial.begin(9600);
-  
   // Create board-specific LED controller
   ledController = createLEDController();
   
+  // Create command handler and open serial communication at the default rate
+  // (the host may negotiate a faster one with BAUD)
+  commandHandler = new SerialCommandHandler(ledController, createTransport());
+  commandHandler->initialize(SERIAL_DEFAULT_BAUD);
+  
   // Initialize LED controller
   ledController->initialize();
-  
-  // Create command handler
-  commandHandler = new SerialCommandHandler(ledController);
 }
 
 void universalLoop() {
@@ -27,4 +32,7 @@ void universalLoop() {
   
   // Process completed commands
   commandHandler->processCommands();
+  
+  // Send queued responses as the transport has room (no flush, no blocking)
+  commandHandler->drainTx();
 }
\ No newline at end of file
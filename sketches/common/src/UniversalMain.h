@@ -3,6 +3,7 @@
 
 #include "LEDController.h"
 #include "SerialCommandHandler.h"
+#include "SerialTransport.h"
 
 /**
  * Universal main loop for all board types
@@ -11,6 +12,14 @@
 
 extern LEDController* createLEDController();
 
+// Link used for commands; the default is the primary Serial port. A board
+// can define its own to use another port, e.g.
+//   Transport* createTransport() {
+//     static SerialTransport<decltype(Serial1)> uart(Serial1);
+//     return &uart;
+//   }
+extern Transport* createTransport();
+
 // Global instances (defined in UniversalMain.cpp)
 extern SerialCommandHandler* commandHandler;
 extern LEDController* ledController;
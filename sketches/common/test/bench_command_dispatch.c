@@ -0,0 +1,127 @@
+/**
+ * Verb dispatch benchmark (host only)
+ *
+ * Compares the hashed CommandRegistry lookup against a linear strncmp
+ * chain as the number of registered verbs grows, up to the registry's
+ * capacity. Registry lookup cost should stay flat; the linear chain grows
+ * with the verb count. The first row times the built-in table through
+ * findCommandSpec().
+ *
+ * Build and run: make bench-dispatch (firmware slot count, then 128 slots
+ * for the curve up to 48 verbs)
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include "CommandProcessor.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_VERBS   48
+#define ITERATIONS  2000000L
+
+// Realistic verb names: the built-in six followed by plausible future verbs
+static const char* VERB_NAMES[MAX_VERBS] = {
+    "ON", "OFF", "COLOR", "BLINK1", "BLINK2", "RAINBOW",
+    "FADE", "PIXELS", "FILL", "CAPS", "HELLO", "STATS", "BAUD", "PING",
+    "QUIET", "ECHO", "FLOW", "CREDIT", "MODE", "BRIGHT", "GAMMA", "PULSE",
+    "BREATHE", "CHASE", "WIPE", "THEATER", "SPARKLE", "FIRE", "STROBE", "SCAN",
+    "GRADIENT", "SHIFT", "ROTATE", "MIRROR", "SAVE", "LOAD", "RESET", "SLEEP",
+    "WAKE", "SYNC", "TIME", "GROUP", "SEGMENT", "LAYER", "MASK", "SPEED",
+    "PAUSE", "RESUME"
+};
+
+static CommandSpec specs[MAX_VERBS];
+static CommandRegistry registry;
+
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Baseline: if/else chain equivalent, first match wins
+static const CommandSpec* linearFind(const char* verb, uint8_t length, int count) {
+    for (int i = 0; i < count; i++) {
+        if (specs[i].verbLength == length && strncmp(specs[i].verb, verb, length) == 0) {
+            return &specs[i];
+        }
+    }
+    return NULL;
+}
+
+static bool setupSpecs(int count) {
+    for (int i = 0; i < count; i++) {
+        specs[i].verb = VERB_NAMES[i];
+        specs[i].verbLength = (uint8_t)strlen(VERB_NAMES[i]);
+        specs[i].opcode = (CommandOpcode)(i + 1);
+        specs[i].arity = 0;
+        specs[i].ranges = NULL;
+        specs[i].lastArgLabel = NULL;
+        specs[i].rejectReason = "invalid parameters";
+        specs[i].payloadUnit = 0;
+    }
+    return commandRegistryInit(&registry, specs, (uint8_t)count);
+}
+
+// Built-in verbs in opcode order
+static int builtInVerbs(const CommandSpec* table[MAX_VERBS]) {
+    int count = 0;
+    const CommandSpec* spec;
+    while (count < MAX_VERBS && (spec = commandSpecForOpcode((CommandOpcode)(count + 1))) != NULL) {
+        table[count++] = spec;
+    }
+    return count;
+}
+
+int main(void) {
+    static const int COUNTS[] = { 6, 12, 24, 32, 48 };
+    volatile unsigned long sink = 0;
+
+    const CommandSpec* builtIn[MAX_VERBS];
+    int builtInCount = builtInVerbs(builtIn);
+
+    printf("Verb dispatch benchmark (%ld lookups per run, %d hash slots, %d verbs max)\n",
+           ITERATIONS, COMMAND_REGISTRY_SLOTS, COMMAND_REGISTRY_CAPACITY);
+
+    double start = nowNs();
+    for (long i = 0; i < ITERATIONS; i++) {
+        const CommandSpec* spec = builtIn[i % builtInCount];
+        const CommandSpec* found = findCommandSpec(spec->verb, spec->verbLength);
+        sink += found ? (unsigned long)found->opcode : 0;
+    }
+    printf("Built-in table: %d verbs, %.2f ns per lookup\n\n",
+           builtInCount, (nowNs() - start) / ITERATIONS);
+
+    printf("%-6s %14s %14s\n", "verbs", "registry ns", "linear ns");
+
+    for (size_t c = 0; c < sizeof(COUNTS) / sizeof(COUNTS[0]); c++) {
+        int count = COUNTS[c];
+        if (count > COMMAND_REGISTRY_CAPACITY) break;
+        if (!setupSpecs(count)) {
+            fprintf(stderr, "Registry refused %d verbs\n", count);
+            return 1;
+        }
+
+        // Look up every registered verb round-robin, worst case for the linear chain included
+        start = nowNs();
+        for (long i = 0; i < ITERATIONS; i++) {
+            const CommandSpec* spec = &specs[i % count];
+            const CommandSpec* found = commandRegistryFind(&registry, spec->verb, spec->verbLength);
+            sink += found ? (unsigned long)found->opcode : 0;
+        }
+        double registryNs = (nowNs() - start) / ITERATIONS;
+
+        start = nowNs();
+        for (long i = 0; i < ITERATIONS; i++) {
+            const CommandSpec* spec = &specs[i % count];
+            const CommandSpec* found = linearFind(spec->verb, spec->verbLength, count);
+            sink += found ? (unsigned long)found->opcode : 0;
+        }
+        double linearNs = (nowNs() - start) / ITERATIONS;
+
+        printf("%-6d %14.2f %14.2f\n", count, registryNs, linearNs);
+    }
+
+    return sink == 0;
+}
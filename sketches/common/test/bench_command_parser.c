@@ -0,0 +1,397 @@
+/**
+ * Command parser microbenchmark (host only)
+ *
+ * Runs processCommand() and the parse*Command() wrappers over a corpus of
+ * valid, invalid and adversarial lines, plus a generated mix of a few
+ * thousand lines over every verb, and reports ns/command and cycles/byte
+ * per corpus group. Results are written as JSON; with a baseline file
+ * recorded on the same machine the run fails when any ns/command figure
+ * exceeds the baseline by more than the margin. A missing baseline skips
+ * the comparison with a warning.
+ *
+ * Build and run: make bench [BENCH_BASELINE=file] [BENCH_MARGIN=percent]
+ * Usage: bench_command_parser [--json out] [--baseline file] [--margin percent]
+ */
+#define _POSIX_C_SOURCE 199309L
+
+#include "CommandProcessor.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_CYCLE_COUNTER 1
+#endif
+
+#define TARGET_NS_PER_RUN 40000000.0  // Each timed run lasts about 40 ms
+#define RUNS_PER_CASE 5                // Fastest run is reported (least disturbed)
+#define MAX_RESULTS 32
+#define NAME_MAX_LENGTH 48
+
+typedef struct {
+    const char* name;
+    const char* const* lines;
+} CorpusGroup;
+
+static const char* const ON_LINES[] = { "ON", " ON ", "ON\r", NULL };
+static const char* const OFF_LINES[] = { "OFF", "OFF\r", NULL };
+static const char* const COLOR_LINES[] = {
+    "COLOR,255,0,0", "COLOR,0,255,0", "COLOR,12,34,56", "COLOR,255,255,255\r", NULL
+};
+static const char* const BLINK1_LINES[] = {
+    "BLINK1,255,0,0,500", "BLINK1,0,0,255,200", "BLINK1,255,255,255,1000\r", NULL
+};
+static const char* const BLINK2_LINES[] = {
+    "BLINK2,255,0,0,0,0,255,500", "BLINK2,0,255,0,255,0,255,250", NULL
+};
+static const char* const RAINBOW_LINES[] = { "RAINBOW,50", "RAINBOW,5", "RAINBOW,2000\r", NULL };
+static const char* const PIXELS_LINES[] = {  // 32 pixels per line
+    "PIXELS,0,"
+    "FF000000FF000000FFFFFFFF101010202020303030404040505050606060707070808080909090A0A0A0B0B0B0"
+    "C0C0C0D0D0D0E0E0E0F0F0F0ff0000ff0000ff0000ff0000ff0000ff0000ff0000ff0000ff0000ff0000ff0000"
+    "00ff0000ff00",
+    NULL
+};
+static const char* const INVALID_LINES[] = {
+    "COLOR,256,0,0", "COLOR,255,0", "BLINK1,255,0,0,0", "RAINBOW,-5", "COLOR,a,b,c",
+    "BLINK2,255,0,0,0,0,255", "UNKNOWN", "", "ON,1", NULL
+};
+static const char* const ADVERSARIAL_LINES[] = {
+    "COLORCOLORCOLORCOLORCOLORCOLOR,1,2,3",
+    "COLOR,99999999999999999999999999,0,0",
+    "COLOR,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,,",
+    "                                        ON                                        ",
+    "BLINK2,255,255,255,255,255,255,2147483647,1,2,3,4,5,6,7,8,9",
+    "RAINBOW,--50", "COLOR,255,0,0;OFF;ON", "#65535,COLOR,255,0,0", "#999999,ON",
+    "\x01\x02\x03\xff\xfe", NULL
+};
+
+// Generated corpus: every verb with random in-range arguments, some lines
+// then corrupted; fixed seed so every run parses the same lines
+#define MIXED_LINE_COUNT 4096
+#define MIXED_LINE_MAX 128
+#define MIXED_INVALID_PERCENT 30
+
+static char mixedPool[MIXED_LINE_COUNT][MIXED_LINE_MAX];
+static const char* MIXED_LINES[MIXED_LINE_COUNT + 1];
+static uint32_t corpusSeed = 12345;
+
+static uint32_t corpusRandom(uint32_t bound) {
+    corpusSeed = corpusSeed * 1103515245u + 12345u;
+    return (corpusSeed >> 8) % bound;
+}
+
+static void generateValidLine(char* line, size_t size) {
+    static const unsigned BAUD_RATES[] = { 9600, 19200, 57600, 115200 };
+    int length = 0;
+    if (corpusRandom(4) == 0) length = snprintf(line, size, "#%u,", (unsigned)corpusRandom(65536));
+    char* out = line + length;
+    size_t room = size - (size_t)length;
+
+    switch (corpusRandom(OPCODE_FADE)) {
+    case 0: snprintf(out, room, "ON"); break;
+    case 1: snprintf(out, room, "OFF"); break;
+    case 2:
+        snprintf(out, room, "COLOR,%u,%u,%u",
+                 (unsigned)corpusRandom(256), (unsigned)corpusRandom(256), (unsigned)corpusRandom(256));
+        break;
+    case 3:
+        snprintf(out, room, "BLINK1,%u,%u,%u,%u", (unsigned)corpusRandom(256), (unsigned)corpusRandom(256),
+                 (unsigned)corpusRandom(256), 1 + (unsigned)corpusRandom(5000));
+        break;
+    case 4:
+        snprintf(out, room, "BLINK2,%u,%u,%u,%u,%u,%u,%u", (unsigned)corpusRandom(256),
+                 (unsigned)corpusRandom(256), (unsigned)corpusRandom(256), (unsigned)corpusRandom(256),
+                 (unsigned)corpusRandom(256), (unsigned)corpusRandom(256), 1 + (unsigned)corpusRandom(5000));
+        break;
+    case 5: snprintf(out, room, "RAINBOW,%u", 1 + (unsigned)corpusRandom(2000)); break;
+    case 6: snprintf(out, room, "ECHO,%u", (unsigned)corpusRandom(2)); break;
+    case 7: snprintf(out, room, "QUIET,%u", (unsigned)corpusRandom(2)); break;
+    case 8: snprintf(out, room, "STATS"); break;
+    case 9: snprintf(out, room, "BAUD,%u", BAUD_RATES[corpusRandom(4)]); break;
+    case 10: snprintf(out, room, "PING"); break;
+    case 11: snprintf(out, room, "FLOW,%u", (unsigned)corpusRandom(2)); break;
+    case 12: {
+        int written = snprintf(out, room, "PIXELS,%u,", (unsigned)corpusRandom(300));
+        for (uint32_t pixels = 1 + corpusRandom(16); pixels > 0; pixels--) {
+            written += snprintf(out + written, room - (size_t)written, "%06X",
+                                (unsigned)corpusRandom(0x1000000));
+        }
+        break;
+    }
+    case 13: snprintf(out, room, "RELIABLE,%u", (unsigned)corpusRandom(2)); break;
+    case 14: snprintf(out, room, "CAPS"); break;
+    case 15:
+        snprintf(out, room, "FILL,%u,%u,%u,%u,%u", (unsigned)corpusRandom(300), 1 + (unsigned)corpusRandom(300),
+                 (unsigned)corpusRandom(256), (unsigned)corpusRandom(256), (unsigned)corpusRandom(256));
+        break;
+    default:
+        snprintf(out, room, "FADE,%u,%u,%u,%u,%u", (unsigned)corpusRandom(256), (unsigned)corpusRandom(256),
+                 (unsigned)corpusRandom(256), (unsigned)corpusRandom(65536), (unsigned)corpusRandom(4));
+        break;
+    }
+}
+
+// Typical corruptions: a stray character, a cut-off line, an extra or
+// out-of-range argument, an unknown verb
+static void corruptLine(char* line, size_t size) {
+    size_t length = strlen(line);
+    switch (corpusRandom(4)) {
+    case 0: line[corpusRandom((uint32_t)length)] = "x,;-#9 "[corpusRandom(7)]; break;
+    case 1: line[1 + corpusRandom((uint32_t)length - 1)] = '\0'; break;
+    case 2: strncat(line, ",999", size - length - 1); break;
+    default: line[0] = (char)('a' + corpusRandom(26)); break;
+    }
+}
+
+static void generateMixedCorpus(void) {
+    int valid = 0;
+    for (int i = 0; i < MIXED_LINE_COUNT; i++) {
+        generateValidLine(mixedPool[i], MIXED_LINE_MAX);
+        if (corpusRandom(100) < MIXED_INVALID_PERCENT) corruptLine(mixedPool[i], MIXED_LINE_MAX);
+        MIXED_LINES[i] = mixedPool[i];
+
+        ParsedCommand parsed;
+        valid += parseCommand(mixedPool[i], &parsed);
+    }
+    MIXED_LINES[MIXED_LINE_COUNT] = NULL;
+    printf("Mixed corpus: %d lines, %d valid\n\n", MIXED_LINE_COUNT, valid);
+}
+
+static const CorpusGroup GROUPS[] = {
+    { "ON", ON_LINES },
+    { "OFF", OFF_LINES },
+    { "COLOR", COLOR_LINES },
+    { "BLINK1", BLINK1_LINES },
+    { "BLINK2", BLINK2_LINES },
+    { "RAINBOW", RAINBOW_LINES },
+    { "PIXELS", PIXELS_LINES },
+    { "invalid", INVALID_LINES },
+    { "adversarial", ADVERSARIAL_LINES },
+    { "mixed", MIXED_LINES },
+};
+#define GROUP_COUNT (sizeof(GROUPS) / sizeof(GROUPS[0]))
+
+typedef void (*LineFunction)(const char* line);
+
+typedef struct {
+    char name[NAME_MAX_LENGTH];
+    double nsPerCommand;
+    double cyclesPerByte;  // < 0 when no cycle counter is available
+} BenchResult;
+
+static BenchResult results[MAX_RESULTS];
+static int resultCount = 0;
+static volatile long sink;
+
+static void runProcessCommand(const char* line) {
+    CommandResponse response;
+    processCommand(line, &response);
+    sink += response.result + response.response[0];
+}
+
+static void runParseCommand(const char* line) {
+    ParsedCommand parsed;
+    sink += parseCommand(line, &parsed) + parsed.argCount;
+}
+
+static void runParseColor(const char* line) {
+    uint8_t r, g, b;
+    sink += parseColorCommand(line, &r, &g, &b);
+}
+
+static void runParseBlink1(const char* line) {
+    uint8_t r, g, b;
+    long interval;
+    sink += parseBlink1Command(line, &r, &g, &b, &interval);
+}
+
+static void runParseBlink2(const char* line) {
+    uint8_t r1, g1, b1, r2, g2, b2;
+    long interval;
+    sink += parseBlink2Command(line, &r1, &g1, &b1, &r2, &g2, &b2, &interval);
+}
+
+static void runParseRainbow(const char* line) {
+    long interval;
+    sink += parseRainbowCommand(line, &interval);
+}
+
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static unsigned long long nowCycles(void) {
+#ifdef HAVE_CYCLE_COUNTER
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// One pass over every line of a group; returns the bytes parsed
+static size_t runPass(LineFunction fn, const char* const* lines, int* count) {
+    size_t bytes = 0;
+    *count = 0;
+    for (const char* const* line = lines; *line; line++) {
+        fn(*line);
+        bytes += strlen(*line) + 1;  // Newline included, as on the wire
+        (*count)++;
+    }
+    return bytes;
+}
+
+static void measure(const char* function, const char* group, LineFunction fn, const char* const* lines) {
+    int perPass;
+    size_t bytesPerPass = runPass(fn, lines, &perPass);  // Warm-up
+
+    // Calibrate the pass count to the target run duration
+    long passes = 1;
+    for (;;) {
+        double start = nowNs();
+        for (long i = 0; i < passes; i++) runPass(fn, lines, &perPass);
+        double elapsed = nowNs() - start;
+        if (elapsed > TARGET_NS_PER_RUN / 10 || passes > (1L << 28)) {
+            passes = (long)(passes * (TARGET_NS_PER_RUN / (elapsed > 1 ? elapsed : 1))) + 1;
+            break;
+        }
+        passes *= 4;
+    }
+
+    double elapsed = 0;
+    unsigned long long cycles = 0;
+    for (int run = 0; run < RUNS_PER_CASE; run++) {
+        double start = nowNs();
+        unsigned long long startCycles = nowCycles();
+        for (long i = 0; i < passes; i++) runPass(fn, lines, &perPass);
+        unsigned long long runCycles = nowCycles() - startCycles;
+        double runNs = nowNs() - start;
+
+        if (run == 0 || runNs < elapsed) {
+            elapsed = runNs;
+            cycles = runCycles;
+        }
+    }
+
+    if (resultCount >= MAX_RESULTS) return;
+    BenchResult* result = &results[resultCount++];
+    snprintf(result->name, sizeof(result->name), "%s/%s", function, group);
+    result->nsPerCommand = elapsed / ((double)passes * perPass);
+#ifdef HAVE_CYCLE_COUNTER
+    result->cyclesPerByte = (double)cycles / ((double)passes * bytesPerPass);
+#else
+    (void)cycles;
+    (void)bytesPerPass;
+    result->cyclesPerByte = -1;
+#endif
+
+    printf("%-30s %12.1f %14.2f\n", result->name, result->nsPerCommand, result->cyclesPerByte);
+}
+
+static int writeJson(const char* path) {
+    FILE* out = fopen(path, "w");
+    if (!out) {
+        fprintf(stderr, "cannot write %s\n", path);
+        return 1;
+    }
+
+    fprintf(out, "{\n  \"results\": {");
+    for (int i = 0; i < resultCount; i++) {
+        fprintf(out, "%s\n    \"%s\": { \"ns_per_command\": %.2f, \"cycles_per_byte\": ",
+                i ? "," : "", results[i].name, results[i].nsPerCommand);
+        if (results[i].cyclesPerByte < 0) {
+            fprintf(out, "null }");
+        } else {
+            fprintf(out, "%.3f }", results[i].cyclesPerByte);
+        }
+    }
+    fprintf(out, "\n  }\n}\n");
+    fclose(out);
+
+    printf("Results written to %s\n", path);
+    return 0;
+}
+
+// Baseline files use the same layout as writeJson(): one result per line
+static int compareBaseline(const char* path, double marginPercent) {
+    FILE* in = fopen(path, "r");
+    if (!in) {
+        fprintf(stderr, "WARNING: no baseline at %s, comparison skipped "
+                        "(record one on this machine with make bench-baseline)\n", path);
+        return 0;
+    }
+
+    int regressions = 0;
+    bool compared[MAX_RESULTS] = { false };
+    char line[256];
+    while (fgets(line, sizeof(line), in)) {
+        char name[NAME_MAX_LENGTH];
+        double baselineNs;
+        if (sscanf(line, " \"%47[^\"]\": { \"ns_per_command\": %lf", name, &baselineNs) != 2) continue;
+
+        for (int i = 0; i < resultCount; i++) {
+            if (strcmp(results[i].name, name) != 0) continue;
+            compared[i] = true;
+            double limit = baselineNs * (1.0 + marginPercent / 100.0);
+            if (results[i].nsPerCommand > limit) {
+                printf("REGRESSION %-30s %.1f ns > %.1f ns (baseline %.1f + %.0f%%)\n",
+                       name, results[i].nsPerCommand, limit, baselineNs, marginPercent);
+                regressions++;
+            }
+        }
+    }
+    fclose(in);
+
+    for (int i = 0; i < resultCount; i++) {
+        if (!compared[i]) {
+            printf("WARNING: %s has no baseline figure (re-record with make bench-baseline)\n",
+                   results[i].name);
+        }
+    }
+
+    if (regressions == 0) {
+        printf("Within %.0f%% of baseline %s\n", marginPercent, path);
+    }
+    return regressions ? 1 : 0;
+}
+
+int main(int argc, char** argv) {
+    const char* jsonPath = "bench_results.json";
+    const char* baselinePath = NULL;
+    double marginPercent = 25.0;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--json") == 0) {
+            jsonPath = argv[i + 1];
+        } else if (strcmp(argv[i], "--baseline") == 0) {
+            baselinePath = argv[i + 1];
+        } else if (strcmp(argv[i], "--margin") == 0) {
+            marginPercent = atof(argv[i + 1]);
+        } else {
+            fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    generateMixedCorpus();
+    printf("%-30s %12s %14s\n", "case", "ns/command", "cycles/byte");
+
+    for (size_t g = 0; g < GROUP_COUNT; g++) {
+        measure("processCommand", GROUPS[g].name, runProcessCommand, GROUPS[g].lines);
+    }
+    for (size_t g = 0; g < GROUP_COUNT; g++) {
+        measure("parseCommand", GROUPS[g].name, runParseCommand, GROUPS[g].lines);
+    }
+    measure("parseColorCommand", "COLOR", runParseColor, COLOR_LINES);
+    measure("parseBlink1Command", "BLINK1", runParseBlink1, BLINK1_LINES);
+    measure("parseBlink2Command", "BLINK2", runParseBlink2, BLINK2_LINES);
+    measure("parseRainbowCommand", "RAINBOW", runParseRainbow, RAINBOW_LINES);
+    measure("parseColorCommand", "invalid", runParseColor, INVALID_LINES);
+
+    if (writeJson(jsonPath) != 0) return 1;
+    return baselinePath ? compareBaseline(baselinePath, marginPercent) : 0;
+}
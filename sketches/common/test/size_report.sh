@@ -0,0 +1,56 @@
+#!/bin/sh
+# Flash usage report for UniversalLedControl on every board
+#
+# Usage: ./size_report.sh [baseline-git-rev]
+#   Compiles sketches/<board>/UniversalLedControl with arduino-cli and prints
+#   the flash bytes used per board. With a baseline revision the same sketches
+#   are also compiled from a temporary git worktree and the saving is shown.
+#   Results are written to size_report.json.
+
+set -e
+
+TEST_DIR=$(cd "$(dirname "$0")" && pwd)
+REPO_ROOT=$(cd "$TEST_DIR/../../.." && pwd)
+CONFIG_FILE=${ARDUINO_CONFIG_FILE:-$REPO_ROOT/arduino-cli.yaml}
+BASELINE=$1
+REPORT="$TEST_DIR/size_report.json"
+
+# Print flash bytes used by one board's sketch: sketch_flash <tree> <board>
+sketch_flash() {
+  fqbn=$(node -p "require('$1/sketches/$2/board.json').fqbn")
+  (cd "$REPO_ROOT" && arduino-cli --config-file "$CONFIG_FILE" compile --fqbn "$fqbn" \
+    --libraries "$1/sketches/common" "$1/sketches/$2/UniversalLedControl" 2>&1) |
+    sed -n 's/^Sketch uses \([0-9]*\) bytes.*/\1/p'
+}
+
+BASELINE_TREE=""
+if [ -n "$BASELINE" ]; then
+  BASELINE_TREE=$(mktemp -d)
+  git -C "$REPO_ROOT" worktree add --detach --quiet "$BASELINE_TREE" "$BASELINE"
+  trap 'git -C "$REPO_ROOT" worktree remove --force "$BASELINE_TREE"' EXIT
+fi
+
+printf '%-20s %10s %10s %10s\n' board current baseline saved
+printf '{\n  "baseline": "%s",\n  "boards": {' "$BASELINE" > "$REPORT"
+
+separator=""
+for board_json in "$REPO_ROOT"/sketches/*/board.json; do
+  board=$(basename "$(dirname "$board_json")")
+  current=$(sketch_flash "$REPO_ROOT" "$board")
+  baseline="-"
+  saved="-"
+  if [ -n "$BASELINE_TREE" ]; then
+    baseline=$(sketch_flash "$BASELINE_TREE" "$board")
+    if [ -n "$current" ] && [ -n "$baseline" ]; then
+      saved=$((baseline - current))
+    fi
+  fi
+
+  printf '%-20s %10s %10s %10s\n' "$board" "${current:-error}" "$baseline" "$saved"
+  printf '%s\n    "%s": { "flash": %s, "baseline": %s, "saved": %s }' "$separator" "$board" \
+    "${current:-null}" "$(echo "$baseline" | sed 's/^-$/null/')" "$(echo "$saved" | sed 's/^-$/null/')" >> "$REPORT"
+  separator=","
+done
+
+printf '\n  }\n}\n' >> "$REPORT"
+echo "Report written to $REPORT"
@@ -0,0 +1,115 @@
+/**
+ * RX path heap soak test (host only)
+ *
+ * Mirrors SerialCommandHandler's receive path (RX ring -> stream decoder ->
+ * command queue -> response writer) for millions of commands while
+ * malloc/calloc/realloc/free are wrapped by the linker. Any heap call after
+ * start-up fails the run.
+ *
+ * Build and run: make soak [SOAK_COMMANDS=n]
+ */
+#include "CommandProcessor.h"
+#include "RingBuffer.h"
+#include "CommandQueue.h"
+#include "BoardConfig.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef SOAK_COMMANDS
+#define SOAK_COMMANDS 2000000L
+#endif
+
+static unsigned long heapCalls = 0;
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+void* __wrap_malloc(size_t size) { heapCalls++; return __real_malloc(size); }
+void* __wrap_calloc(size_t count, size_t size) { heapCalls++; return __real_calloc(count, size); }
+void* __wrap_realloc(void* ptr, size_t size) { heapCalls++; return __real_realloc(ptr, size); }
+void __wrap_free(void* ptr) { heapCalls++; __real_free(ptr); }
+
+static const char* const LINES[] = {
+    "ON\n", "OFF\r\n", "COLOR,255,0,0\n", "BLINK1,0,0,255,200\n",
+    "BLINK2,255,0,0,0,0,255,500\n", "RAINBOW,50\n", "COLOR,256,0,0\n",
+    "OFF;COLOR,1,2,3;RAINBOW,9\n", "#42,ON\n", "UNKNOWN,1,2\n",
+    "COLORCOLORCOLORCOLORCOLOR,1\n", "COLOR,99999999999999999999,0,0\n",
+    "PIXELS,0,FF000000FF000000FF\n"
+};
+#define LINE_COUNT (sizeof(LINES) / sizeof(LINES[0]))
+
+static uint8_t rxStorage[SERIAL_RX_RING_SIZE];
+static RingBuffer rx;
+static CommandStream stream;
+static QueuedCommand queueStorage[COMMAND_QUEUE_SIZE];
+static CommandQueue queue;
+static char txLine[RESPONSE_MAX_LENGTH];
+
+int main(void) {
+    ringBufferInit(&rx, rxStorage, sizeof(rxStorage));
+    commandQueueInit(&queue, queueStorage, COMMAND_QUEUE_SIZE);
+    commandStreamReset(&stream);
+    setvbuf(stdout, NULL, _IONBF, 0);  // Keep stdio from allocating later
+
+    unsigned long long bytes = 0;
+    unsigned long responses = 0;
+    long commands = 0;
+    unsigned long heapAtStart = heapCalls;
+
+    while (commands < SOAK_COMMANDS) {
+        // "UART" side: push whole lines while they fit
+        const char* line = LINES[commands % LINE_COUNT];
+        size_t length = strlen(line);
+        if (ringBufferFree(&rx) < length) {
+            fprintf(stderr, "ring too small for corpus line\n");
+            return 1;
+        }
+        for (size_t i = 0; i < length; i++) {
+            ringBufferPush(&rx, (uint8_t)line[i]);
+        }
+        bytes += length;
+        commands++;
+
+        // Handler side: decode from the ring into the queue, then answer
+        uint8_t c;
+        while (ringBufferPop(&rx, &c)) {
+            if (commandStreamFeed(&stream, (char)c)) {
+                commandQueuePushStream(&queue, &stream);
+            }
+        }
+
+        const QueuedCommand* entry;
+        while ((entry = commandQueueFront(&queue)) != NULL) {
+            if (!entry->inBatch || entry->lineComplete) {
+                ResponseWriter writer;
+                responseWriterInit(&writer, txLine, sizeof(txLine));
+                if (entry->inBatch) {
+                    writeBatchSummary(&writer, &entry->batch, &entry->command);
+                } else {
+                    writeResponse(&writer, entry->verb, &entry->command, ECHO_FULL);
+                }
+                responseEndLine(&writer);
+                responses++;
+            }
+            commandQueueDrop(&queue);
+        }
+        if (commandQueueTakeOverflow(&queue) != 0) {
+            fprintf(stderr, "queue too small for corpus line\n");
+            return 1;
+        }
+    }
+
+    unsigned long heapDuringRun = heapCalls - heapAtStart;
+    printf("%ld commands, %llu bytes, %lu responses, ring %d bytes, queue %d, heap calls %lu\n",
+           commands, bytes, responses, SERIAL_RX_RING_SIZE, COMMAND_QUEUE_SIZE, heapDuringRun);
+
+    if (heapDuringRun != 0 || responses != (unsigned long)commands) {
+        printf("SOAK FAILED\n");
+        return 1;
+    }
+    printf("SOAK OK\n");
+    return 0;
+}
@@ -1,6 +1,17 @@
 #include "unity.h"
 #include "CommandProcessor.h"
+#include "FrameCodec.h"
+#include "RingBuffer.h"
+#include "CommandQueue.h"
+#include "ReliableLink.h"
+#include "FrameBuffer.h"
+#include "AnimationClock.h"
+#include "ColorTables.h"
+#include "Transition.h"
+#include "BoardConfig.h"
 #include <string.h>
+#include <stdlib.h>
+#include <limits.h>
 
 // Test setup and teardown
 void setUp(void) {
@@ -164,7 +175,1065 @@ void test_U1_017_EmptyStringHandling(void) {
     TEST_ASSERT_EQUAL_STRING("REJECT,,unknown command", response.response);
 }
 
+// U1-018: Single-pass parse fills typed ParsedCommand
+void test_U1_018_ParsedCommandFields(void) {
+    ParsedCommand parsed;
+    TEST_ASSERT_TRUE(parseCommand("BLINK2,255,0,0,0,0,255,300", &parsed));
+    
+    TEST_ASSERT_EQUAL(OPCODE_BLINK2, parsed.opcode);
+    TEST_ASSERT_EQUAL(PARSE_OK, parsed.error);
+    TEST_ASSERT_EQUAL(7, parsed.argCount);
+    TEST_ASSERT_EQUAL(255, parsed.args[0]);
+    TEST_ASSERT_EQUAL(255, parsed.args[5]);
+    TEST_ASSERT_EQUAL(300, parsed.args[6]);
+}
+
+// U1-019: Non-numeric argument rejection
+void test_U1_019_NonNumericArgument(void) {
+    CommandResponse response;
+    processCommand("BLINK1,abc,0,0,500", &response);
+    
+    TEST_ASSERT_EQUAL(COMMAND_REJECTED, response.result);
+    TEST_ASSERT_EQUAL_STRING("REJECT,BLINK1,abc,0,0,500,invalid parameters", response.response);
+}
+
+// U1-020: Numeric overflow rejection
+void test_U1_020_NumericOverflow(void) {
+    ParsedCommand parsed;
+    TEST_ASSERT_FALSE(parseCommand("RAINBOW,99999999999999999999", &parsed));
+    
+    TEST_ASSERT_EQUAL(OPCODE_RAINBOW, parsed.opcode);
+    TEST_ASSERT_EQUAL(PARSE_INVALID_ARGS, parsed.error);
+}
+
+// U1-021: Registry lookup matches whole verbs only
+void test_U1_021_RegistryVerbLookup(void) {
+    const CommandSpec* spec = findCommandSpec("BLINK2", 6);
+    TEST_ASSERT_NOT_NULL(spec);
+    TEST_ASSERT_EQUAL(OPCODE_BLINK2, spec->opcode);
+    TEST_ASSERT_EQUAL(spec, commandSpecForOpcode(OPCODE_BLINK2));
+    
+    TEST_ASSERT_NULL(findCommandSpec("BLINK", 5));
+    TEST_ASSERT_NULL(findCommandSpec("ONX", 3));
+}
+
+// Feed bytes to a stream decoder, returning how many lines completed
+static int feedStream(CommandStream* stream, const char* bytes) {
+    int completed = 0;
+    while (*bytes) {
+        if (commandStreamFeed(stream, *bytes++)) completed++;
+    }
+    return completed;
+}
+
+// U1-022: Streaming decode completes at the newline (CRLF, split input)
+void test_U1_022_StreamDecodeAtNewline(void) {
+    CommandStream stream;
+    commandStreamReset(&stream);
+    
+    TEST_ASSERT_EQUAL(0, feedStream(&stream, "\r\nBLINK1,0,25"));
+    TEST_ASSERT_EQUAL(0, feedStream(&stream, "5,0,200\r"));
+    TEST_ASSERT_EQUAL(1, feedStream(&stream, "\n"));
+    
+    TEST_ASSERT_EQUAL(OPCODE_BLINK1, stream.command.opcode);
+    TEST_ASSERT_EQUAL(PARSE_OK, stream.command.error);
+    TEST_ASSERT_EQUAL(255, stream.command.args[1]);
+    TEST_ASSERT_EQUAL(200, stream.command.args[3]);
+}
+
+// U1-023: Streaming reject echoes the verb only
+void test_U1_023_StreamRejectEcho(void) {
+    CommandStream stream;
+    CommandResponse response;
+    commandStreamReset(&stream);
+    
+    TEST_ASSERT_EQUAL(1, feedStream(&stream, "COLOR,256,0,0\n"));
+    buildResponse(stream.verb, &stream.command, &response);
+    
+    TEST_ASSERT_EQUAL(COMMAND_REJECTED, response.result);
+    TEST_ASSERT_EQUAL_STRING("REJECT,COLOR,invalid format", response.response);
+}
+
+// U1-024: Decimal kernels format extremes and detect overflow
+void test_U1_024_DecimalKernels(void) {
+    char text[DECIMAL_MAX_CHARS + 1];
+    
+    text[formatDecimal(0, text)] = '\0';
+    TEST_ASSERT_EQUAL_STRING("0", text);
+    text[formatDecimal(-750, text)] = '\0';
+    TEST_ASSERT_EQUAL_STRING("-750", text);
+    text[formatDecimal(LONG_MIN, text)] = '\0';
+    TEST_ASSERT_EQUAL(LONG_MIN, strtol(text, NULL, 10));
+    text[formatUnsigned(ULONG_MAX, text)] = '\0';
+    TEST_ASSERT_EQUAL(ULONG_MAX, strtoul(text, NULL, 10));
+    
+    long value = LONG_MAX / 10;
+    TEST_ASSERT_TRUE(decimalAccumulate(&value, (char)('0' + LONG_MAX % 10)));
+    TEST_ASSERT_EQUAL(LONG_MAX, value);
+    TEST_ASSERT_FALSE(decimalAccumulate(&value, '0'));
+    TEST_ASSERT_FALSE(decimalAccumulate(&value, 'x'));
+}
+
+// U1-025: Compact echo acknowledges with the verb only
+void test_U1_025_CompactEchoResponse(void) {
+    char line[RESPONSE_MAX_LENGTH];
+    ResponseWriter writer;
+    ParsedCommand parsed;
+    
+    parseCommand("BLINK2,255,0,0,0,0,255,750", &parsed);
+    responseWriterInit(&writer, line, sizeof(line));
+    TEST_ASSERT_EQUAL(COMMAND_ACCEPTED, writeResponse(&writer, "BLINK2", &parsed, ECHO_COMPACT));
+    responseEndLine(&writer);
+    
+    TEST_ASSERT_EQUAL_STRING("ACCEPTED,BLINK2\r\n", line);
+    TEST_ASSERT_EQUAL(17, writer.length);
+}
+
+// U1-026: Writer truncates at capacity but keeps the line end
+void test_U1_026_WriterTruncation(void) {
+    char line[12];
+    ResponseWriter writer;
+    
+    responseWriterInit(&writer, line, sizeof(line));
+    responseAppendLiteral(&writer, "ACCEPTED,");
+    responseAppendInt(&writer, 123456);
+    responseEndLine(&writer);
+    
+    TEST_ASSERT_TRUE(writer.overflow);
+    TEST_ASSERT_EQUAL_STRING("ACCEPTED,\r\n", line);
+}
+
+// U1-027: COBS frame round trip with embedded zero bytes
+void test_U1_027_FrameRoundTrip(void) {
+    const uint8_t payload[] = { 0x03, 0x00, 0xFF, 0x00, 0x00, 0x11 };
+    uint8_t encoded[FRAME_ENCODED_SIZE(sizeof(payload))];
+    uint8_t length = frameEncode(payload, sizeof(payload), encoded);
+    
+    TEST_ASSERT_EQUAL_UINT8(FRAME_DELIMITER, encoded[0]);
+    TEST_ASSERT_EQUAL_UINT8(FRAME_DELIMITER, encoded[length - 1]);
+    for (uint8_t i = 1; i < length - 1; i++) {
+        TEST_ASSERT_NOT_EQUAL(0, encoded[i]);
+    }
+    
+    FrameDecoder decoder;
+    frameDecoderReset(&decoder);
+    bool complete = false;
+    for (uint8_t i = 0; i < length; i++) {
+        complete = frameDecoderFeed(&decoder, encoded[i]);
+    }
+    
+    TEST_ASSERT_TRUE(complete);
+    TEST_ASSERT_FALSE(decoder.error);
+    TEST_ASSERT_EQUAL_UINT8(sizeof(payload), decoder.length);
+    TEST_ASSERT_EQUAL_MEMORY(payload, decoder.payload, sizeof(payload));
+}
+
+// U1-028: Binary command decode and CRC rejection
+void test_U1_028_DecodeCommandFrame(void) {
+    // BLINK2: six 1-byte channels, 4-byte little-endian interval (500 ms)
+    uint8_t payload[] = { OPCODE_BLINK2, 255, 0, 0, 0, 0, 255, 0xF4, 0x01, 0x00, 0x00, 0 };
+    payload[sizeof(payload) - 1] = crc8(payload, sizeof(payload) - 1);
+    
+    ParsedCommand parsed;
+    TEST_ASSERT_TRUE(decodeCommandFrame(payload, sizeof(payload), &parsed));
+    TEST_ASSERT_EQUAL(OPCODE_BLINK2, parsed.opcode);
+    TEST_ASSERT_EQUAL_UINT8(7, parsed.argCount);
+    TEST_ASSERT_EQUAL(255, parsed.args[0]);
+    TEST_ASSERT_EQUAL(255, parsed.args[5]);
+    TEST_ASSERT_EQUAL(500, parsed.args[6]);
+    
+    payload[1] ^= 0x01;  // Corrupt one byte: CRC no longer matches
+    TEST_ASSERT_FALSE(decodeCommandFrame(payload, sizeof(payload), &parsed));
+    TEST_ASSERT_EQUAL(PARSE_BAD_FRAME, parsed.error);
+    
+    // Zero interval is out of range, same rule as the text protocol
+    uint8_t zero[] = { OPCODE_RAINBOW, 0, 0, 0, 0, 0 };
+    zero[sizeof(zero) - 1] = crc8(zero, sizeof(zero) - 1);
+    TEST_ASSERT_FALSE(decodeCommandFrame(zero, sizeof(zero), &parsed));
+    TEST_ASSERT_EQUAL(PARSE_INVALID_ARGS, parsed.error);
+}
+
+// U1-029: Batch items complete at each separator, one summary per line
+void test_U1_029_BatchSummary(void) {
+    CommandStream stream;
+    char line[RESPONSE_MAX_LENGTH];
+    ResponseWriter writer;
+    commandStreamReset(&stream);
+    
+    TEST_ASSERT_EQUAL(1, feedStream(&stream, "OFF;"));
+    TEST_ASSERT_EQUAL(OPCODE_OFF, stream.command.opcode);
+    TEST_ASSERT_TRUE(commandStreamInBatch(&stream));
+    TEST_ASSERT_FALSE(stream.lineComplete);
+    
+    TEST_ASSERT_EQUAL(2, feedStream(&stream, "COLOR,255,0,0;BLINK1,0,0,255,200\n"));
+    TEST_ASSERT_EQUAL(OPCODE_BLINK1, stream.command.opcode);
+    TEST_ASSERT_TRUE(stream.lineComplete);
+    
+    responseWriterInit(&writer, line, sizeof(line));
+    TEST_ASSERT_EQUAL(COMMAND_ACCEPTED, writeBatchSummary(&writer, &stream.batch, &stream.command));
+    responseEndLine(&writer);
+    TEST_ASSERT_EQUAL_STRING("ACCEPTED,BATCH,3,111\r\n", line);
+    
+    // The next line starts a fresh batch; a single command is not a batch
+    TEST_ASSERT_EQUAL(1, feedStream(&stream, "ON\n"));
+    TEST_ASSERT_FALSE(commandStreamInBatch(&stream));
+}
+
+// U1-030: Failed and empty batch items clear their status bit
+void test_U1_030_BatchRejectedItems(void) {
+    CommandStream stream;
+    char line[RESPONSE_MAX_LENGTH];
+    ResponseWriter writer;
+    commandStreamReset(&stream);
+    
+    TEST_ASSERT_EQUAL(4, feedStream(&stream, "ON;COLOR,256,0,0;;RAINBOW,50\n"));
+    
+    responseWriterInit(&writer, line, sizeof(line));
+    TEST_ASSERT_EQUAL(COMMAND_REJECTED, writeBatchSummary(&writer, &stream.batch, &stream.command));
+    TEST_ASSERT_EQUAL_STRING("REJECT,BATCH,4,1001", line);
+    
+    // parseCommand stops at the separator
+    ParsedCommand parsed;
+    TEST_ASSERT_TRUE(parseCommand("OFF;ON", &parsed));
+    TEST_ASSERT_EQUAL(OPCODE_OFF, parsed.opcode);
+}
+
+// U1-031: Sequence tag is echoed in accept, reject and batch responses
+void test_U1_031_SequenceTagEcho(void) {
+    CommandResponse response;
+    
+    processCommand("#42,COLOR,255,0,0", &response);
+    TEST_ASSERT_EQUAL(COMMAND_ACCEPTED, response.result);
+    TEST_ASSERT_EQUAL_STRING("ACCEPTED,#42,COLOR,255,0,0", response.response);
+    
+    processCommand("#7,RAINBOW,0", &response);
+    TEST_ASSERT_EQUAL_STRING("REJECT,#7,RAINBOW,0,invalid interval", response.response);
+    
+    CommandStream stream;
+    char line[RESPONSE_MAX_LENGTH];
+    ResponseWriter writer;
+    commandStreamReset(&stream);
+    
+    TEST_ASSERT_EQUAL(2, feedStream(&stream, "#65535,OFF;ON\n"));
+    responseWriterInit(&writer, line, sizeof(line));
+    writeBatchSummary(&writer, &stream.batch, &stream.command);
+    TEST_ASSERT_EQUAL_STRING("ACCEPTED,#65535,BATCH,2,11", line);
+    
+    // The tag belongs to one line only
+    TEST_ASSERT_EQUAL(1, feedStream(&stream, "OFF\n"));
+    TEST_ASSERT_FALSE(stream.command.tagged);
+}
+
+// U1-032: Malformed sequence tags are rejected without an echoed tag
+void test_U1_032_MalformedSequenceTag(void) {
+    ParsedCommand parsed;
+    
+    TEST_ASSERT_FALSE(parseCommand("#65536,ON", &parsed));
+    TEST_ASSERT_EQUAL(PARSE_UNKNOWN_COMMAND, parsed.error);
+    TEST_ASSERT_FALSE(parsed.tagged);
+    
+    TEST_ASSERT_FALSE(parseCommand("#,ON", &parsed));
+    TEST_ASSERT_FALSE(parseCommand("#12", &parsed));
+    TEST_ASSERT_FALSE(parseCommand("ON,#12", &parsed));
+    
+    // A tag alone still gets an answer, so a pipelining host never waits on it
+    TEST_ASSERT_FALSE(parseCommand("#3,", &parsed));
+    TEST_ASSERT_TRUE(parsed.tagged);
+    TEST_ASSERT_EQUAL(3, parsed.tag);
+}
+
+// U1-033: Quiet mode silences accepts and tags rejects with the sequence
+void test_U1_033_QuietModeFilter(void) {
+    QuietMode quiet;
+    ParsedCommand parsed;
+    CommandResponse response;
+    quietModeSet(&quiet, false);
+    
+    parseCommand("ON", &parsed);
+    TEST_ASSERT_TRUE(quietModeFilter(&quiet, &parsed, true));  // Disabled: all answered
+    
+    TEST_ASSERT_TRUE(parseCommand("QUIET,1", &parsed));
+    quietModeSet(&quiet, parsed.args[0] != 0);
+    TEST_ASSERT_TRUE(quietModeFilter(&quiet, &parsed, true));  // QUIET itself is answered
+    
+    parseCommand("COLOR,255,0,0", &parsed);
+    TEST_ASSERT_FALSE(quietModeFilter(&quiet, &parsed, true));
+    
+    parseCommand("COLOR,256,0,0", &parsed);
+    TEST_ASSERT_TRUE(quietModeFilter(&quiet, &parsed, false));
+    buildResponse("COLOR", &parsed, &response);
+    TEST_ASSERT_EQUAL_STRING("REJECT,#2,COLOR,invalid format", response.response);
+    
+    // An explicit tag wins over the sequence number
+    parseCommand("#9,RAINBOW,0", &parsed);
+    TEST_ASSERT_TRUE(quietModeFilter(&quiet, &parsed, false));
+    TEST_ASSERT_EQUAL(9, parsed.tag);
+    TEST_ASSERT_EQUAL(3, quiet.sequence);
+}
+
+// U1-034: Ring buffer wraps by masking and refuses writes when full
+void test_U1_034_RingBufferWrap(void) {
+    uint8_t storage[4];
+    RingBuffer ring;
+    uint8_t byte;
+    ringBufferInit(&ring, storage, sizeof(storage));
+    
+    TEST_ASSERT_FALSE(ringBufferPop(&ring, &byte));
+    for (int round = 0; round < 3; round++) {  // Indices run past the size
+        for (uint8_t i = 0; i < 4; i++) {
+            TEST_ASSERT_TRUE(ringBufferPush(&ring, (uint8_t)(round * 4 + i)));
+        }
+        TEST_ASSERT_FALSE(ringBufferPush(&ring, 0xFF));
+        TEST_ASSERT_EQUAL(0, ringBufferFree(&ring));
+        
+        for (uint8_t i = 0; i < 4; i++) {
+            TEST_ASSERT_TRUE(ringBufferPop(&ring, &byte));
+            TEST_ASSERT_EQUAL_UINT8(round * 4 + i, byte);
+        }
+        TEST_ASSERT_EQUAL(0, ringBufferCount(&ring));
+    }
+    
+    // Free-running indices stay correct across the uint16_t wrap
+    ring.head = ring.tail = 0xFFFE;
+    TEST_ASSERT_TRUE(ringBufferPush(&ring, 1));
+    TEST_ASSERT_TRUE(ringBufferPush(&ring, 2));
+    TEST_ASSERT_TRUE(ringBufferPush(&ring, 3));
+    TEST_ASSERT_EQUAL(3, ringBufferCount(&ring));
+    TEST_ASSERT_TRUE(ringBufferPop(&ring, &byte));
+    TEST_ASSERT_EQUAL_UINT8(1, byte);
+}
+
+// U1-035: Command queue keeps arrival order and counts dropped commands
+void test_U1_035_CommandQueueOverflow(void) {
+    QueuedCommand storage[2];
+    CommandQueue queue;
+    CommandStream stream;
+    commandQueueInit(&queue, storage, 2);
+    commandStreamReset(&stream);
+    
+    // Drain-all: three completed items arrive before any of them runs
+    const char* input = "ON;OFF;RAINBOW,50\n";
+    while (*input) {
+        if (commandStreamFeed(&stream, *input++)) commandQueuePushStream(&queue, &stream);
+    }
+    
+    TEST_ASSERT_EQUAL(2, commandQueueCount(&queue));
+    TEST_ASSERT_TRUE(commandQueueFull(&queue));
+    TEST_ASSERT_EQUAL(1, commandQueueTakeOverflow(&queue));
+    TEST_ASSERT_EQUAL(0, commandQueueTakeOverflow(&queue));
+    
+    // The dropped item is marked rejected in the line's summary
+    TEST_ASSERT_TRUE(stream.batch.rejected & (1UL << 2));
+    
+    const QueuedCommand* entry = commandQueueFront(&queue);
+    TEST_ASSERT_EQUAL(OPCODE_ON, entry->command.opcode);
+    TEST_ASSERT_TRUE(entry->inBatch);
+    commandQueueDrop(&queue);
+    TEST_ASSERT_FALSE(commandQueueFull(&queue));
+    TEST_ASSERT_EQUAL(OPCODE_OFF, commandQueueFront(&queue)->command.opcode);
+    commandQueueDrop(&queue);
+    TEST_ASSERT_NULL(commandQueueFront(&queue));
+    
+    // Frames share the queue
+    ParsedCommand parsed;
+    parseCommand("COLOR,1,2,3", &parsed);
+    TEST_ASSERT_TRUE(commandQueuePushFrame(&queue, &parsed));
+    TEST_ASSERT_EQUAL(QUEUED_FRAME, commandQueueFront(&queue)->source);
+}
+
+// U1-036: Queue overflow is reported as an explicit REJECT line
+void test_U1_036_QueueOverflowReport(void) {
+    char line[RESPONSE_MAX_LENGTH];
+    ResponseWriter writer;
+    
+    responseWriterInit(&writer, line, sizeof(line));
+    writeQueueOverflow(&writer, 3);
+    responseEndLine(&writer);
+    
+    TEST_ASSERT_EQUAL_STRING("REJECT,QUEUE,overflow,3\r\n", line);
+}
+
+// U1-037: STATS reports TX ring counters and is answered in quiet mode
+void test_U1_037_StatsResponse(void) {
+    char line[RESPONSE_MAX_LENGTH];
+    ResponseWriter writer;
+    ParsedCommand parsed;
+    QuietMode quiet;
+    SerialStats stats = { 412, 1024, 2, 4096, 3, 1, 4000000000UL, 70000 };
+    
+    TEST_ASSERT_TRUE(parseCommand("STATS", &parsed));
+    TEST_ASSERT_EQUAL(OPCODE_STATS, parsed.opcode);
+    
+    quietModeSet(&quiet, true);
+    TEST_ASSERT_TRUE(quietModeFilter(&quiet, &parsed, true));
+    TEST_ASSERT_EQUAL(0, quiet.sequence);  // Not counted as a quiet command
+    
+    responseWriterInit(&writer, line, sizeof(line));
+    writeResponse(&writer, "STATS", &parsed, ECHO_FULL);
+    writeStats(&writer, &stats);
+    responseEndLine(&writer);
+    TEST_ASSERT_EQUAL_STRING("ACCEPTED,STATS,tx_high=412,tx_size=1024,tx_stalls=2,payload_max=4096,naks=3,dups=1,shows=4000000000,skips=70000\r\n", line);
+    
+    // The longest possible STATS line still fits
+    SerialStats largest = { 65535, 65535, 65535, 65535, 65535, 65535, UINT32_MAX, UINT32_MAX };
+    TEST_ASSERT_TRUE(parseCommand("#65535,STATS", &parsed));
+    responseWriterInit(&writer, line, sizeof(line));
+    writeResponse(&writer, "STATS", &parsed, ECHO_FULL);
+    writeStats(&writer, &largest);
+    TEST_ASSERT_FALSE(writer.overflow);
+    TEST_ASSERT_EQUAL_STRING(",skips=4294967295", line + writer.length - 17);
+    
+    TEST_ASSERT_FALSE(parseCommand("STATS,1", &parsed));
+}
+
+// U1-038: BAUD accepts rates up to the board maximum; PING is a bare ack
+void test_U1_038_BaudAndPing(void) {
+    CommandResponse response;
+    ParsedCommand parsed;
+    QuietMode quiet;
+    
+    processCommand("BAUD,115200", &response);
+    TEST_ASSERT_EQUAL_STRING("ACCEPTED,BAUD,115200", response.response);
+    processCommand("BAUD,300", &response);
+    TEST_ASSERT_EQUAL_STRING("REJECT,BAUD,300,unsupported rate", response.response);
+    processCommand("BAUD,1000000", &response);  // Above SERIAL_BAUD_MAX (921600)
+    TEST_ASSERT_EQUAL_STRING("REJECT,BAUD,1000000,unsupported rate", response.response);
+    
+    processCommand("#7,PING", &response);
+    TEST_ASSERT_EQUAL_STRING("ACCEPTED,#7,PING", response.response);
+    
+    // The handshake is answered in quiet mode; the rate travels as 4 bytes in frames
+    quietModeSet(&quiet, true);
+    TEST_ASSERT_TRUE(parseCommand("PING", &parsed));
+    TEST_ASSERT_TRUE(quietModeFilter(&quiet, &parsed, true));
+    TEST_ASSERT_TRUE(parseCommand("BAUD,921600", &parsed));
+    TEST_ASSERT_TRUE(quietModeFilter(&quiet, &parsed, true));
+    TEST_ASSERT_EQUAL(0, quiet.sequence);
+    TEST_ASSERT_EQUAL(4, commandArgWidth(&commandSpecForOpcode(OPCODE_BAUD)->ranges[0]));
+}
+
+// U1-039: Flow control grants free slots and returns one credit per entry
+void test_U1_039_FlowControlCredits(void) {
+    char line[RESPONSE_MAX_LENGTH];
+    ResponseWriter writer;
+    ParsedCommand parsed;
+    FlowControl flow;
+    
+    flowControlSet(&flow, false);
+    flowControlRelease(&flow, 3);
+    TEST_ASSERT_EQUAL(0, flowControlTake(&flow, 16));  // Disabled: no CREDIT lines
+    
+    TEST_ASSERT_TRUE(parseCommand("FLOW,1", &parsed));
+    TEST_ASSERT_EQUAL(OPCODE_FLOW, parsed.opcode);
+    flowControlSet(&flow, parsed.args[0] != 0);
+    flowControlRelease(&flow, 1);                       // Queued FLOW dropped after running
+    TEST_ASSERT_EQUAL(16, flowControlTake(&flow, 16));  // Free slots, not 17
+    TEST_ASSERT_EQUAL(0, flowControlTake(&flow, 16));
+    
+    flowControlSet(&flow, true);                        // FLOW in a reliable frame holds no slot
+    TEST_ASSERT_EQUAL(14, flowControlTake(&flow, 14));  // Two commands still queued
+    
+    flowControlRelease(&flow, 2);  // Two commands run in one loop
+    responseWriterInit(&writer, line, sizeof(line));
+    writeCredit(&writer, flowControlTake(&flow, 16));
+    responseEndLine(&writer);
+    TEST_ASSERT_EQUAL_STRING("CREDIT,2\r\n", line);
+    
+    flowControlRelease(&flow, 5);
+    flowControlSet(&flow, false);  // FLOW,0 discards pending credits
+    TEST_ASSERT_EQUAL(0, flowControlTake(&flow, 16));
+}
+
+// U1-040: PIXELS payloads are handed out a pixel at a time, never buffered
+void test_U1_040_PixelsPayloadStream(void) {
+    CommandStream stream;
+    CommandResponse response;
+    ParsedCommand parsed;
+    uint8_t pixels[2][3];
+    uint16_t units = 0;
+    commandStreamReset(&stream);
+    
+    const char* line = "PIXELS,4,FF000000ff80\n";
+    bool complete = false;
+    for (const char* c = line; *c; c++) {
+        complete = commandStreamFeed(&stream, *c);
+        if (stream.unitReady) {
+            TEST_ASSERT_EQUAL(4, stream.command.args[0]);  // Start index known before the payload
+            memcpy(pixels[units++], stream.unit, 3);
+        }
+    }
+    TEST_ASSERT_TRUE(complete);
+    TEST_ASSERT_EQUAL(PARSE_OK, stream.command.error);
+    TEST_ASSERT_EQUAL(OPCODE_PIXELS, stream.command.opcode);
+    TEST_ASSERT_EQUAL(2, units);
+    TEST_ASSERT_EQUAL_UINT8(0xFF, pixels[0][0]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, pixels[0][2]);
+    TEST_ASSERT_EQUAL_UINT8(0xFF, pixels[1][1]);
+    TEST_ASSERT_EQUAL_UINT8(0x80, pixels[1][2]);
+    
+    processCommand("PIXELS,0,0A0B0C\r", &response);
+    TEST_ASSERT_EQUAL_STRING("ACCEPTED,PIXELS,0,count=1", response.response);
+    processCommand("PIXELS,0,FF00", &response);  // Partial pixel
+    TEST_ASSERT_EQUAL_STRING("REJECT,PIXELS,0,FF00,invalid parameters", response.response);
+    TEST_ASSERT_FALSE(parseCommand("PIXELS,0,", &parsed));   // Empty payload
+    TEST_ASSERT_FALSE(parseCommand("PIXELS,0", &parsed));    // No payload
+    TEST_ASSERT_FALSE(parseCommand("PIXELS,0,GG0000", &parsed));
+    
+    // One byte over the board limit is rejected as soon as it arrives
+    static char big[16 + 2 * (PAYLOAD_MAX_BYTES + 3)];
+    strcpy(big, "PIXELS,0,");
+    memset(big + strlen(big), 'A', 2 * (PAYLOAD_MAX_BYTES / 3 * 3));
+    TEST_ASSERT_TRUE(parseCommand(big, &parsed));
+    TEST_ASSERT_EQUAL(PAYLOAD_MAX_BYTES / 3, parsed.args[1]);
+    memset(big + strlen(big), 'A', 6);
+    TEST_ASSERT_FALSE(parseCommand(big, &parsed));
+    TEST_ASSERT_EQUAL(PARSE_PAYLOAD_TOO_LONG, parsed.error);
+    buildResponse("PIXELS", &parsed, &response);  // The stream path echoes the verb only
+    TEST_ASSERT_EQUAL_STRING("REJECT,PIXELS,payload too long", response.response);
+    
+    // Payload verbs have no binary form
+    uint8_t frame[] = { OPCODE_PIXELS, 0, 0, 0 };
+    frame[sizeof(frame) - 1] = crc8(frame, sizeof(frame) - 1);
+    TEST_ASSERT_FALSE(decodeCommandFrame(frame, sizeof(frame), &parsed));
+    TEST_ASSERT_EQUAL(PARSE_UNKNOWN_COMMAND, parsed.error);
+}
+
+// Reliable frame payload: sequence, opcode, arguments, CRC-8 seeded with the length
+static uint8_t reliableFrame(uint8_t* payload, uint8_t sequence, CommandOpcode opcode, uint8_t arg) {
+    payload[0] = sequence;
+    payload[1] = (uint8_t)opcode;
+    payload[2] = arg;
+    payload[3] = crc8Seeded(3, payload, 3);
+    return 4;
+}
+
+// U1-041: Reliable mode holds frames past a gap, NAKs the gap once, re-acks duplicates
+void test_U1_041_ReliableWindow(void) {
+    ReliableSlot slots[4];
+    uint8_t statuses[4];
+    ReliableLink link;
+    ParsedCommand parsed;
+    uint8_t payload[4];
+    uint8_t sequence = 0;
+    uint8_t nak = 0;
+    
+    reliableLinkInit(&link, slots, statuses, 4);
+    reliableLinkSet(&link, true);
+    TEST_ASSERT_EQUAL(4, reliableLinkWindow(&link));
+    
+    // Frame 0 in sequence
+    TEST_ASSERT_TRUE(decodeReliableFrame(payload, reliableFrame(payload, 0, OPCODE_ECHO, 1), &sequence, &parsed));
+    TEST_ASSERT_EQUAL(OPCODE_ECHO, parsed.opcode);
+    TEST_ASSERT_EQUAL(RELIABLE_RUN, reliableLinkReceive(&link, sequence, &parsed));
+    TEST_ASSERT_FALSE(reliableLinkNextHeld(&link, &parsed, &sequence));
+    TEST_ASSERT_FALSE(reliableLinkTakeNak(&link, &nak));
+    
+    // Frame 1 corrupted on the wire, 2 and 3 (invalid argument) arrive
+    reliableFrame(payload, 1, OPCODE_QUIET, 0);
+    payload[2] ^= 0x40;
+    TEST_ASSERT_FALSE(decodeReliableFrame(payload, 4, &sequence, &parsed));
+    TEST_ASSERT_EQUAL(PARSE_BAD_FRAME, parsed.error);
+    TEST_ASSERT_EQUAL(RELIABLE_DROPPED, reliableLinkReceive(&link, sequence, &parsed));
+    TEST_ASSERT_TRUE(reliableLinkTakeNak(&link, &nak));
+    TEST_ASSERT_EQUAL(1, nak);
+    decodeReliableFrame(payload, reliableFrame(payload, 2, OPCODE_ECHO, 0), &sequence, &parsed);
+    TEST_ASSERT_EQUAL(RELIABLE_HELD, reliableLinkReceive(&link, sequence, &parsed));
+    decodeReliableFrame(payload, reliableFrame(payload, 3, OPCODE_ECHO, 7), &sequence, &parsed);
+    TEST_ASSERT_EQUAL(RELIABLE_HELD, reliableLinkReceive(&link, sequence, &parsed));
+    TEST_ASSERT_FALSE(reliableLinkTakeNak(&link, &nak));  // Same gap: one NAK
+    
+    // Frame 5 is beyond the window and ignored
+    decodeReliableFrame(payload, reliableFrame(payload, 5, OPCODE_ECHO, 1), &sequence, &parsed);
+    TEST_ASSERT_EQUAL(RELIABLE_DROPPED, reliableLinkReceive(&link, sequence, &parsed));
+    
+    // The resent frame 1 releases 2 and 3 in order
+    decodeReliableFrame(payload, reliableFrame(payload, 1, OPCODE_QUIET, 0), &sequence, &parsed);
+    TEST_ASSERT_EQUAL(RELIABLE_RUN, reliableLinkReceive(&link, sequence, &parsed));
+    TEST_ASSERT_TRUE(reliableLinkNextHeld(&link, &parsed, &sequence));
+    TEST_ASSERT_EQUAL(2, sequence);
+    TEST_ASSERT_EQUAL(PARSE_OK, parsed.error);
+    TEST_ASSERT_TRUE(reliableLinkNextHeld(&link, &parsed, &sequence));
+    TEST_ASSERT_EQUAL(3, sequence);
+    TEST_ASSERT_EQUAL(PARSE_INVALID_ARGS, parsed.error);
+    TEST_ASSERT_FALSE(reliableLinkNextHeld(&link, &parsed, &sequence));
+    TEST_ASSERT_FALSE(reliableLinkTakeNak(&link, &nak));
+    
+    // A resent frame that already ran is acknowledged with its original status
+    decodeReliableFrame(payload, reliableFrame(payload, 3, OPCODE_ECHO, 7), &sequence, &parsed);
+    TEST_ASSERT_EQUAL(RELIABLE_DUPLICATE, reliableLinkReceive(&link, sequence, &parsed));
+    TEST_ASSERT_EQUAL(PARSE_INVALID_ARGS, reliableLinkStatus(&link, 3));
+    TEST_ASSERT_EQUAL(1, link.naks);
+    TEST_ASSERT_EQUAL(1, link.duplicates);
+    
+    // Acknowledgement and NAK frames
+    uint8_t out[FRAME_ENCODED_SIZE(RELIABLE_RESPONSE_PAYLOAD)];
+    FrameDecoder decoder;
+    frameDecoderReset(&decoder);
+    uint8_t length = encodeReliableResponseFrame(3, &parsed, out);
+    for (uint8_t i = 0; i < length; i++) frameDecoderFeed(&decoder, out[i]);
+    TEST_ASSERT_EQUAL(RELIABLE_RESPONSE_PAYLOAD, decoder.length);
+    TEST_ASSERT_EQUAL_UINT8(3, decoder.payload[0]);
+    TEST_ASSERT_EQUAL_UINT8(OPCODE_ECHO, decoder.payload[1]);
+    TEST_ASSERT_EQUAL_UINT8(PARSE_INVALID_ARGS, decoder.payload[2]);
+    TEST_ASSERT_EQUAL_UINT8(crc8Seeded(3, decoder.payload, 3), decoder.payload[3]);
+    
+    // Two frames merged by a lost delimiter fail the seeded CRC
+    uint8_t merged[9];
+    reliableFrame(merged, 4, OPCODE_ON, 0);
+    merged[4] = 0;
+    reliableFrame(merged + 5, 5, OPCODE_ON, 0);
+    TEST_ASSERT_FALSE(decodeReliableFrame(merged, sizeof(merged), &sequence, &parsed));
+    TEST_ASSERT_EQUAL(PARSE_BAD_FRAME, parsed.error);
+}
+
+// U1-042: CAPS reports the device and the verbs its LED runs natively
+void test_U1_042_Capabilities(void) {
+    char line[RESPONSE_MAX_LENGTH];
+    ResponseWriter writer;
+    ParsedCommand parsed;
+    QuietMode quiet;
+    DeviceCaps caps = { "RGB", 8, 1024, 921600, capsVerbMask(true, true, true) };
+    
+    TEST_ASSERT_TRUE(parseCommand("CAPS", &parsed));
+    TEST_ASSERT_EQUAL(OPCODE_CAPS, parsed.opcode);
+    TEST_ASSERT_FALSE(parseCommand("CAPS,1", &parsed));
+    
+    parseCommand("CAPS", &parsed);
+    quietModeSet(&quiet, true);
+    TEST_ASSERT_TRUE(quietModeFilter(&quiet, &parsed, true));
+    TEST_ASSERT_EQUAL(0, quiet.sequence);
+    
+    responseWriterInit(&writer, line, sizeof(line));
+    writeResponse(&writer, "CAPS", &parsed, ECHO_FULL);
+    writeCaps(&writer, &caps);
+    responseEndLine(&writer);
+    TEST_ASSERT_EQUAL_STRING("ACCEPTED,CAPS,proto=1,led=RGB,pixels=8,rx=1024,baud_max=921600,verbs=3FFFE\r\n", line);
+    
+    // A single-color LED would down-convert COLOR, BLINK2, RAINBOW, PIXELS, FILL and FADE
+    TEST_ASSERT_EQUAL_HEX32(0xDF96, capsVerbMask(false, false, false));
+    TEST_ASSERT_EQUAL_HEX32(0x3FFBE, capsVerbMask(true, true, false));
+}
+
+// U1-043: Framebuffer covers the whole strip; FILL addresses a run of pixels
+void test_U1_043_FrameBufferFill(void) {
+    uint8_t storage[5 * 3];
+    FrameBuffer fb;
+    memset(storage, 0xAA, sizeof(storage));
+    frameBufferInit(&fb, storage, 5);
+    TEST_ASSERT_EQUAL_UINT8(0, frameBufferPixel(&fb, 4)[2]);
+    
+    frameBufferSet(&fb, 4, 1, 2, 3);
+    frameBufferSet(&fb, 5, 9, 9, 9);  // Past the end: ignored
+    TEST_ASSERT_EQUAL_UINT8(3, frameBufferPixel(&fb, 4)[2]);
+    TEST_ASSERT_NULL(frameBufferPixel(&fb, 5));
+    
+    // Runs are clipped to the strip
+    TEST_ASSERT_EQUAL_UINT16(3, frameBufferFill(&fb, 2, 100, 0, 0, 255));
+    TEST_ASSERT_EQUAL_UINT16(0, frameBufferFill(&fb, 5, 1, 255, 0, 0));
+    TEST_ASSERT_EQUAL_UINT8(0, frameBufferPixel(&fb, 1)[2]);
+    TEST_ASSERT_EQUAL_UINT8(255, frameBufferPixel(&fb, 4)[2]);
+    frameBufferClear(&fb);
+    TEST_ASSERT_EQUAL_UINT8(0, frameBufferPixel(&fb, 4)[2]);
+    
+    ParsedCommand parsed;
+    TEST_ASSERT_TRUE(parseCommand("FILL,10,50,255,128,0", &parsed));
+    TEST_ASSERT_EQUAL(OPCODE_FILL, parsed.opcode);
+    TEST_ASSERT_EQUAL(50, parsed.args[1]);
+    TEST_ASSERT_FALSE(parseCommand("FILL,0,0,255,0,0", &parsed));  // Empty run
+    TEST_ASSERT_FALSE(parseCommand("FILL,0,1,256,0,0", &parsed));
+    TEST_ASSERT_FALSE(parseCommand("FILL,0,1,255,0", &parsed));
+    
+    // Binary form: 2-byte start and count, three 1-byte channels
+    uint8_t payload[] = { OPCODE_FILL, 0x2C, 0x01, 0x2C, 0x01, 0, 255, 0, 0 };
+    payload[sizeof(payload) - 1] = crc8(payload, sizeof(payload) - 1);
+    TEST_ASSERT_TRUE(decodeCommandFrame(payload, sizeof(payload), &parsed));
+    TEST_ASSERT_EQUAL(300, parsed.args[0]);
+    TEST_ASSERT_EQUAL(300, parsed.args[1]);
+    TEST_ASSERT_EQUAL(255, parsed.args[3]);
+}
+
+// U1-044: Only pixels that actually change make the framebuffer dirty
+void test_U1_044_FrameBufferDirtyRange(void) {
+    uint8_t storage[8 * 3];
+    FrameBuffer fb;
+    uint16_t first, end;
+    frameBufferInit(&fb, storage, 8);
+    
+    // A new buffer is wholly dirty so the first frame is always shown
+    TEST_ASSERT_TRUE(frameBufferTakeDirty(&fb, &first, &end));
+    TEST_ASSERT_EQUAL_UINT16(0, first);
+    TEST_ASSERT_EQUAL_UINT16(8, end);
+    TEST_ASSERT_FALSE(frameBufferTakeDirty(&fb, &first, &end));
+    
+    // Rewriting the same colors changes nothing
+    frameBufferClear(&fb);
+    frameBufferSet(&fb, 3, 0, 0, 0);
+    TEST_ASSERT_FALSE(frameBufferTakeDirty(&fb, &first, &end));
+    
+    // Separate changes merge into one range covering both
+    frameBufferSet(&fb, 5, 255, 0, 0);
+    frameBufferSet(&fb, 2, 0, 255, 0);
+    TEST_ASSERT_TRUE(frameBufferTakeDirty(&fb, &first, &end));
+    TEST_ASSERT_EQUAL_UINT16(2, first);
+    TEST_ASSERT_EQUAL_UINT16(6, end);
+    
+    // A fill over partly matching pixels marks only those it changed
+    frameBufferFill(&fb, 0, 8, 255, 0, 0);
+    TEST_ASSERT_TRUE(frameBufferTakeDirty(&fb, &first, &end));
+    TEST_ASSERT_EQUAL_UINT16(0, first);
+    TEST_ASSERT_EQUAL_UINT16(8, end);
+    frameBufferSet(&fb, 6, 0, 0, 255);
+    frameBufferFill(&fb, 4, 4, 255, 0, 0);
+    TEST_ASSERT_TRUE(frameBufferTakeDirty(&fb, &first, &end));
+    TEST_ASSERT_EQUAL_UINT16(6, first);
+    TEST_ASSERT_EQUAL_UINT16(7, end);
+    frameBufferFill(&fb, 0, 8, 255, 0, 0);
+    TEST_ASSERT_FALSE(frameBufferTakeDirty(&fb, &first, &end));
+}
+
+// U1-045: Animation phase follows elapsed time, not the number of updates
+void test_U1_045_AnimationClock(void) {
+    AnimationClock clock;
+    animationClockStart(&clock, 1000, 100);
+    
+    TEST_ASSERT_EQUAL_UINT32(0, animationClockAdvance(&clock, 1099));
+    TEST_ASSERT_EQUAL_UINT32(1, animationClockAdvance(&clock, 1130));  // Serviced late
+    TEST_ASSERT_EQUAL_UINT32(0, animationClockAdvance(&clock, 1199));  // Deadline stays at 1200
+    TEST_ASSERT_EQUAL_UINT32(1, animationClockAdvance(&clock, 1200));
+    
+    // A 470 ms stall catches up by the steps it missed, then stays on schedule
+    TEST_ASSERT_EQUAL_UINT32(4, animationClockAdvance(&clock, 1670));
+    TEST_ASSERT_EQUAL_UINT32(6, clock.step);
+    TEST_ASSERT_EQUAL_UINT32(0, animationClockAdvance(&clock, 1699));
+    TEST_ASSERT_EQUAL_UINT32(1, animationClockAdvance(&clock, 1700));
+    
+    // Polling every millisecond for 10 s keeps the step exact (no drift)
+    animationClockStart(&clock, 0, 7);
+    for (uint32_t now = 1; now <= 10000; now++) {
+        animationClockAdvance(&clock, now);
+    }
+    TEST_ASSERT_EQUAL_UINT32(10000 / 7, clock.step);
+    
+    // millis() wrap-around
+    animationClockStart(&clock, 0xFFFFFFC0UL, 100);
+    TEST_ASSERT_EQUAL_UINT32(1, animationClockAdvance(&clock, 0x00000024UL));
+    TEST_ASSERT_EQUAL_UINT32(0x00000024UL, clock.lastTick);
+}
+
+// U1-046: Table-driven rainbow matches the Adafruit wheel and gamma curve
+void test_U1_046_ColorTables(void) {
+    uint8_t r, g, b;
+    TEST_ASSERT_EQUAL_UINT8(0, colorGamma8(0));
+    TEST_ASSERT_EQUAL_UINT8(42, colorGamma8(128));
+    TEST_ASSERT_EQUAL_UINT8(255, colorGamma8(255));
+    
+    // Wheel positions: red, orange-yellow, blue, and back to red past a full turn
+    colorHue(0, &r, &g, &b);
+    TEST_ASSERT_TRUE(r == 255 && g == 0 && b == 0);
+    colorHue(42 * 256, &r, &g, &b);  // ColorHSV(): h = 251 of 1530
+    TEST_ASSERT_TRUE(r == 255 && g == colorGamma8(251) && b == 0);
+    colorHue(42 * 256 + 100, &r, &g, &b);  // Rounds to the same position
+    TEST_ASSERT_EQUAL_UINT8(colorGamma8(251), g);
+    colorHue(43690, &r, &g, &b);
+    TEST_ASSERT_TRUE(r == 0 && g == 0 && b == 255);
+    colorHue(65500, &r, &g, &b);
+    TEST_ASSERT_TRUE(r == 255 && g == 0 && b == 0);
+    
+    // Three pixels a third of a turn apart, starting from blue
+    uint8_t storage[3 * 3];
+    FrameBuffer fb;
+    frameBufferInit(&fb, storage, 3);
+    colorRainbowFill(&fb, 43690);
+    TEST_ASSERT_EQUAL_UINT8(255, frameBufferPixel(&fb, 0)[2]);
+    TEST_ASSERT_EQUAL_UINT8(255, frameBufferPixel(&fb, 1)[0]);
+    TEST_ASSERT_EQUAL_UINT8(255, frameBufferPixel(&fb, 2)[1]);
+    TEST_ASSERT_EQUAL_UINT8(0, frameBufferPixel(&fb, 2)[0]);
+}
+
+// U1-047: FADE weights follow the easing LUT in fixed point over the duration
+void test_U1_047_Transition(void) {
+    Transition fade;
+    transitionStart(&fade, 1000, 1000, EASE_LINEAR);
+    TEST_ASSERT_EQUAL_UINT16(0, transitionWeight(&fade, 1000));
+    TEST_ASSERT_EQUAL_UINT16(64, transitionWeight(&fade, 1250));
+    TEST_ASSERT_EQUAL_UINT16(128, transitionWeight(&fade, 1500));
+    TEST_ASSERT_EQUAL_UINT16(TRANSITION_WEIGHT_MAX, transitionWeight(&fade, 2000));
+    TEST_ASSERT_EQUAL_UINT16(TRANSITION_WEIGHT_MAX, transitionWeight(&fade, 90000));
+    
+    // Eased curves share the endpoints and bend the middle
+    transitionStart(&fade, 0, 1000, EASE_IN);
+    TEST_ASSERT_EQUAL_UINT16(64, transitionWeight(&fade, 500));
+    transitionStart(&fade, 0, 1000, EASE_OUT);
+    TEST_ASSERT_EQUAL_UINT16(192, transitionWeight(&fade, 500));
+    transitionStart(&fade, 0, 1000, EASE_IN_OUT);
+    TEST_ASSERT_EQUAL_UINT16(128, transitionWeight(&fade, 500));
+    TEST_ASSERT_TRUE(transitionWeight(&fade, 100) < 16);
+    transitionStart(&fade, 0, 0, EASE_IN_OUT);  // Zero duration finishes at once
+    TEST_ASSERT_EQUAL_UINT16(TRANSITION_WEIGHT_MAX, transitionWeight(&fade, 0));
+    
+    // Each pixel blends from its own snapshot towards the target
+    uint8_t from[2 * 3] = { 255, 0, 0, 0, 0, 0 };
+    uint8_t storage[2 * 3];
+    FrameBuffer fb;
+    frameBufferInit(&fb, storage, 2);
+    transitionRender(&fb, from, 0, 0, 200, 128);
+    TEST_ASSERT_EQUAL_UINT8(127, frameBufferPixel(&fb, 0)[0]);
+    TEST_ASSERT_EQUAL_UINT8(100, frameBufferPixel(&fb, 0)[2]);
+    TEST_ASSERT_EQUAL_UINT8(100, frameBufferPixel(&fb, 1)[2]);
+    transitionRender(&fb, from, 0, 0, 200, TRANSITION_WEIGHT_MAX);
+    TEST_ASSERT_EQUAL_UINT8(0, frameBufferPixel(&fb, 0)[0]);
+    TEST_ASSERT_EQUAL_UINT8(200, frameBufferPixel(&fb, 0)[2]);
+    
+    ParsedCommand parsed;
+    TEST_ASSERT_TRUE(parseCommand("FADE,0,0,255,800,3", &parsed));
+    TEST_ASSERT_EQUAL(OPCODE_FADE, parsed.opcode);
+    TEST_ASSERT_EQUAL(800, parsed.args[3]);
+    TEST_ASSERT_FALSE(parseCommand("FADE,0,0,255,800,4", &parsed));
+    TEST_ASSERT_FALSE(parseCommand("FADE,0,0,255,65536,0", &parsed));
+    TEST_ASSERT_FALSE(parseCommand("FADE,0,0,255,800", &parsed));
+}
+
 // Main test runner
+// Feed a PIXELS line the way SerialCommandHandler does: a fresh stage at the
+// first unit, each unit staged, the stage dropped if the line is rejected
+static ParseError stagePixelsLine(FrameStage* stage, const char* line) {
+    CommandStream stream;
+    commandStreamReset(&stream);
+    for (const char* c = line; *c; c++) {
+        if (commandStreamFeed(&stream, *c)) break;
+        if (!stream.unitReady) continue;
+        if (stream.unitCount == 1) frameStageDiscard(stage);
+        frameStageSet(stage, (uint16_t)(stream.command.args[0] + stream.unitCount - 1),
+                      stream.unit[0], stream.unit[1], stream.unit[2]);
+    }
+    if (stream.command.error != PARSE_OK) frameStageDiscard(stage);
+    return stream.command.error;
+}
+
+// U1-048: A rejected PIXELS leaves the framebuffer and a running animation alone
+void test_U1_048_RejectedPixelsStaged(void) {
+    uint8_t frameStorage[4 * 3], stageStorage[4 * 3];
+    FrameBuffer fb;
+    FrameStage stage;
+    frameBufferInit(&fb, frameStorage, 4);
+    frameStageInit(&stage, stageStorage, 4);
+    uint16_t first, end;
+    
+    // A blink is running: its lit frame has been shown
+    AnimationClock clock;
+    animationClockStart(&clock, 1000, 100);
+    TEST_ASSERT_EQUAL_UINT32(1, animationClockAdvance(&clock, 1100));
+    frameBufferFill(&fb, 0, 4, 0, 0, 255);
+    frameBufferTakeDirty(&fb, &first, &end);
+    
+    // Partial unit, bad hex, payload too long: one pixel staged before each failure
+    TEST_ASSERT_EQUAL(PARSE_INVALID_ARGS, stagePixelsLine(&stage, "PIXELS,0,FF0000FF\n"));
+    TEST_ASSERT_EQUAL(0, frameStageCommit(&stage, &fb));  // Nothing left to commit
+    TEST_ASSERT_EQUAL(PARSE_INVALID_ARGS, stagePixelsLine(&stage, "PIXELS,1,00FF00GG\n"));
+    static char big[16 + 2 * (PAYLOAD_MAX_BYTES + 3)];
+    strcpy(big, "PIXELS,2,");
+    memset(big + strlen(big), 'A', 2 * (PAYLOAD_MAX_BYTES + 3));
+    strcat(big, "\n");
+    TEST_ASSERT_EQUAL(PARSE_PAYLOAD_TOO_LONG, stagePixelsLine(&stage, big));
+    
+    frameStageCommit(&stage, &fb);
+    TEST_ASSERT_FALSE(frameBufferTakeDirty(&fb, &first, &end));  // Next show() is skipped
+    for (uint16_t i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_UINT8(0, frameBufferPixel(&fb, i)[0]);
+        TEST_ASSERT_EQUAL_UINT8(255, frameBufferPixel(&fb, i)[2]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, animationClockAdvance(&clock, 1200));  // Still on schedule
+    TEST_ASSERT_EQUAL_UINT32(2, clock.step);
+    
+    // An accepted PIXELS commits only its own run
+    TEST_ASSERT_EQUAL(PARSE_INVALID_ARGS, stagePixelsLine(&stage, "PIXELS,0,FF0000FF\n"));
+    TEST_ASSERT_EQUAL(PARSE_OK, stagePixelsLine(&stage, "PIXELS,2,00FF00\n"));
+    TEST_ASSERT_EQUAL(1, frameStageCommit(&stage, &fb));
+    TEST_ASSERT_TRUE(frameBufferTakeDirty(&fb, &first, &end));
+    TEST_ASSERT_EQUAL(2, first);
+    TEST_ASSERT_EQUAL(3, end);
+    TEST_ASSERT_EQUAL_UINT8(0, frameBufferPixel(&fb, 0)[0]);
+    TEST_ASSERT_EQUAL_UINT8(255, frameBufferPixel(&fb, 2)[1]);
+}
+
+// Queue every item completed by bytes, as SerialCommandHandler does
+static void queueStream(CommandQueue* queue, CommandStream* stream, const char* bytes) {
+    while (*bytes) {
+        if (commandStreamFeed(stream, *bytes++)) commandQueuePushStream(queue, stream);
+    }
+}
+
+// Run the oldest queued entry against the baud confirmation
+static CommandOpcode runQueuedBaud(CommandQueue* queue, BaudConfirm* confirm) {
+    const QueuedCommand* entry = commandQueueFront(queue);
+    CommandOpcode opcode = entry->command.opcode;
+    baudConfirmQueued(confirm, entry->command.error == PARSE_OK);
+    commandQueueDrop(queue);
+    return opcode;
+}
+
+// U1-049: Commands queued before a rate switch do not confirm the new rate
+void test_U1_049_BaudConfirmFence(void) {
+    QueuedCommand storage[4];
+    CommandQueue queue;
+    CommandStream stream;
+    BaudConfirm confirm;
+    commandQueueInit(&queue, storage, 4);
+    commandStreamReset(&stream);
+    baudConfirmReset(&confirm);
+    
+    // ON was decoded at the old rate, behind BAUD; then the link goes silent
+    queueStream(&queue, &stream, "BAUD,115200\nON\n");
+    TEST_ASSERT_EQUAL(OPCODE_BAUD, runQueuedBaud(&queue, &confirm));
+    baudConfirmStart(&confirm, commandQueueCount(&queue), 1000);
+    TEST_ASSERT_EQUAL(OPCODE_ON, runQueuedBaud(&queue, &confirm));
+    TEST_ASSERT_TRUE(confirm.pending);
+    TEST_ASSERT_FALSE(baudConfirmExpired(&confirm, 1999, 1000));
+    TEST_ASSERT_TRUE(baudConfirmExpired(&confirm, 2000, 1000));   // Falls back
+    TEST_ASSERT_FALSE(baudConfirmExpired(&confirm, 2500, 1000));  // Only once
+    
+    // A PING decoded after the switch confirms it, even behind fenced entries
+    queueStream(&queue, &stream, "BAUD,230400\nCOLOR,1,2,3\n");
+    runQueuedBaud(&queue, &confirm);
+    baudConfirmStart(&confirm, commandQueueCount(&queue), 0xFFFFFF00);
+    queueStream(&queue, &stream, "COLOR,256,0,0\nPING\n");
+    TEST_ASSERT_EQUAL(OPCODE_COLOR, runQueuedBaud(&queue, &confirm));  // Fenced
+    runQueuedBaud(&queue, &confirm);                                   // Invalid
+    TEST_ASSERT_TRUE(confirm.pending);
+    TEST_ASSERT_EQUAL(OPCODE_PING, runQueuedBaud(&queue, &confirm));
+    TEST_ASSERT_FALSE(confirm.pending);
+    TEST_ASSERT_FALSE(baudConfirmExpired(&confirm, 0x00000400, 1000));
+    
+    // A reliable frame bypasses the queue and confirms directly
+    baudConfirmStart(&confirm, 0, 0);
+    baudConfirmDirect(&confirm);
+    TEST_ASSERT_FALSE(baudConfirmExpired(&confirm, 5000, 1000));
+}
+
+// U1-050: A batch whose last item overflows the queue is still answered
+void test_U1_050_BatchSummaryOnOverflow(void) {
+    QueuedCommand storage[2];
+    CommandQueue queue;
+    CommandStream stream;
+    char line[RESPONSE_MAX_LENGTH];
+    ResponseWriter writer;
+    commandQueueInit(&queue, storage, 2);
+    commandStreamReset(&stream);
+    
+    // The summary moves to OFF, the line's newest queued item
+    const char* input = "#4,ON;OFF;COLOR,1,2,3\n";
+    bool orphaned = false;
+    while (*input) {
+        if (commandStreamFeed(&stream, *input++) && !commandQueuePushStream(&queue, &stream)) {
+            orphaned = commandQueueRehomeSummary(&queue, &stream);
+        }
+    }
+    TEST_ASSERT_FALSE(orphaned);
+    TEST_ASSERT_FALSE(commandQueueFront(&queue)->lineComplete);
+    commandQueueDrop(&queue);
+    const QueuedCommand* entry = commandQueueFront(&queue);
+    TEST_ASSERT_EQUAL(OPCODE_OFF, entry->command.opcode);
+    TEST_ASSERT_TRUE(entry->lineComplete);
+    responseWriterInit(&writer, line, sizeof(line));
+    writeBatchSummary(&writer, &entry->batch, &entry->command);
+    TEST_ASSERT_EQUAL_STRING("REJECT,#4,BATCH,3,110", line);
+    commandQueueDrop(&queue);
+    
+    // Nothing of the line is queued: the caller answers it at once
+    commandStreamReset(&stream);
+    input = "ON\nOFF\n#5,PING;STATS\n";
+    while (*input) {
+        if (commandStreamFeed(&stream, *input++) && !commandQueuePushStream(&queue, &stream)) {
+            orphaned = commandQueueRehomeSummary(&queue, &stream);
+        }
+    }
+    TEST_ASSERT_TRUE(orphaned);
+    TEST_ASSERT_TRUE(commandQueueFront(&queue)->lineComplete);  // Single commands untouched
+    responseWriterInit(&writer, line, sizeof(line));
+    writeBatchSummary(&writer, &stream.batch, &stream.command);
+    TEST_ASSERT_EQUAL_STRING("REJECT,#5,BATCH,2,00", line);
+    
+    // A dropped single command is reported as overflow only
+    TEST_ASSERT_EQUAL(1, feedStream(&stream, "ON\n"));
+    TEST_ASSERT_FALSE(commandQueuePushStream(&queue, &stream));
+    TEST_ASSERT_FALSE(commandQueueRehomeSummary(&queue, &stream));
+}
+
+// U1-051: Built-in table row i describes opcode i + 1 and every verb is registered
+void test_U1_051_CommandTableOpcodeOrder(void) {
+    for (int opcode = OPCODE_ON; opcode <= OPCODE_FADE; opcode++) {
+        const CommandSpec* spec = commandSpecForOpcode((CommandOpcode)opcode);
+        TEST_ASSERT_NOT_NULL(spec);
+        TEST_ASSERT_EQUAL(opcode, spec->opcode);
+        TEST_ASSERT_EQUAL(strlen(spec->verb), spec->verbLength);
+        TEST_ASSERT_EQUAL(spec, findCommandSpec(spec->verb, spec->verbLength));
+    }
+    
+    // OPCODE_FADE is the last row; a new verb extends this test
+    TEST_ASSERT_NULL(commandSpecForOpcode((CommandOpcode)(OPCODE_FADE + 1)));
+}
+
+// U1-052: A registry past its capacity refuses the whole table instead of dropping verbs
+void test_U1_052_RegistryOverflowRefused(void) {
+    static CommandSpec specs[COMMAND_REGISTRY_CAPACITY + 1];
+    static char verbs[COMMAND_REGISTRY_CAPACITY + 1][3];
+    CommandRegistry registry;
+    
+    for (uint8_t i = 0; i <= COMMAND_REGISTRY_CAPACITY; i++) {
+        verbs[i][0] = 'V';
+        verbs[i][1] = (char)('A' + i / 26);
+        verbs[i][2] = (char)('A' + i % 26);
+        specs[i] = *commandSpecForOpcode(OPCODE_PING);
+        specs[i].verb = verbs[i];
+        specs[i].verbLength = 3;
+    }
+    
+    TEST_ASSERT_TRUE(commandRegistryInit(&registry, specs, COMMAND_REGISTRY_CAPACITY));
+    TEST_ASSERT_EQUAL(COMMAND_REGISTRY_CAPACITY, registry.count);
+    for (uint8_t i = 0; i < COMMAND_REGISTRY_CAPACITY; i++) {
+        TEST_ASSERT_EQUAL(&specs[i], commandRegistryFind(&registry, verbs[i], 3));
+    }
+    
+    TEST_ASSERT_FALSE(commandRegistryInit(&registry, specs, COMMAND_REGISTRY_CAPACITY + 1));
+    TEST_ASSERT_EQUAL(0, registry.count);
+    TEST_ASSERT_NULL(commandRegistryFind(&registry, verbs[0], 3));
+}
+
+// U1-053: BAUD accepts only the board's listed rates, as text and as a frame
+void test_U1_053_BaudRateList(void) {
+    ParsedCommand parsed;
+    uint8_t frame[6] = { OPCODE_BAUD, 0x39, 0x30, 0x00, 0x00, 0 };  // 12345
+    
+    TEST_ASSERT_TRUE(parseCommand("BAUD,9600", &parsed));
+    TEST_ASSERT_TRUE(parseCommand("BAUD,460800", &parsed));
+    TEST_ASSERT_FALSE(parseCommand("BAUD,12345", &parsed));
+    TEST_ASSERT_EQUAL(PARSE_INVALID_ARGS, parsed.error);
+    TEST_ASSERT_FALSE(parseCommand("BAUD,1200", &parsed));
+    
+    frame[5] = crc8(frame, 5);
+    TEST_ASSERT_FALSE(decodeCommandFrame(frame, sizeof(frame), &parsed));
+    TEST_ASSERT_EQUAL(PARSE_INVALID_ARGS, parsed.error);
+    frame[1] = 0x00;  // 115200 = 0x01C200
+    frame[2] = 0xC2;
+    frame[3] = 0x01;
+    frame[5] = crc8(frame, 5);
+    TEST_ASSERT_TRUE(decodeCommandFrame(frame, sizeof(frame), &parsed));
+    TEST_ASSERT_EQUAL(115200, parsed.args[0]);
+}
+
+// U1-054: "-0" is rejected for unsigned arguments, as the original parser did
+void test_U1_054_NegativeZeroRejected(void) {
+    CommandResponse response;
+    processCommand("COLOR,-0,0,0", &response);
+    
+    TEST_ASSERT_EQUAL(COMMAND_REJECTED, response.result);
+    TEST_ASSERT_EQUAL_STRING("REJECT,COLOR,-0,0,0,invalid format", response.response);
+    
+    ParsedCommand parsed;
+    TEST_ASSERT_FALSE(parseCommand("BLINK1,0,0,0,-0", &parsed));
+    TEST_ASSERT_EQUAL(PARSE_INVALID_ARGS, parsed.error);
+}
+
 int main(void) {
     UNITY_BEGIN();
     
@@ -195,5 +1264,96 @@ int main(void) {
     RUN_TEST(test_U1_016_UnknownCommandHandling);
     RUN_TEST(test_U1_017_EmptyStringHandling);
     
+    // Parsed Command Structure (U1-018 to U1-020)
+    RUN_TEST(test_U1_018_ParsedCommandFields);
+    RUN_TEST(test_U1_019_NonNumericArgument);
+    RUN_TEST(test_U1_020_NumericOverflow);
+    
+    // Command Registry (U1-021)
+    RUN_TEST(test_U1_021_RegistryVerbLookup);
+    
+    // Streaming Decoder (U1-022, U1-023)
+    RUN_TEST(test_U1_022_StreamDecodeAtNewline);
+    RUN_TEST(test_U1_023_StreamRejectEcho);
+    
+    // Decimal Kernels (U1-024)
+    RUN_TEST(test_U1_024_DecimalKernels);
+    
+    // Response Writer (U1-025, U1-026)
+    RUN_TEST(test_U1_025_CompactEchoResponse);
+    RUN_TEST(test_U1_026_WriterTruncation);
+    
+    // Binary Framing (U1-027, U1-028)
+    RUN_TEST(test_U1_027_FrameRoundTrip);
+    RUN_TEST(test_U1_028_DecodeCommandFrame);
+    
+    // Batches (U1-029, U1-030)
+    RUN_TEST(test_U1_029_BatchSummary);
+    RUN_TEST(test_U1_030_BatchRejectedItems);
+    
+    // Sequence Tags (U1-031, U1-032)
+    RUN_TEST(test_U1_031_SequenceTagEcho);
+    RUN_TEST(test_U1_032_MalformedSequenceTag);
+    
+    // Quiet Mode (U1-033)
+    RUN_TEST(test_U1_033_QuietModeFilter);
+    
+    // RX Ring Buffer (U1-034)
+    RUN_TEST(test_U1_034_RingBufferWrap);
+    
+    // Command Queue (U1-035, U1-036)
+    RUN_TEST(test_U1_035_CommandQueueOverflow);
+    RUN_TEST(test_U1_036_QueueOverflowReport);
+    
+    // Transmit Statistics (U1-037)
+    RUN_TEST(test_U1_037_StatsResponse);
+    
+    // Baud Rate Negotiation (U1-038)
+    RUN_TEST(test_U1_038_BaudAndPing);
+    
+    // Flow Control (U1-039)
+    RUN_TEST(test_U1_039_FlowControlCredits);
+    
+    // Payload Commands (U1-040)
+    RUN_TEST(test_U1_040_PixelsPayloadStream);
+    
+    // Reliable Mode (U1-041)
+    RUN_TEST(test_U1_041_ReliableWindow);
+    
+    // Capabilities (U1-042)
+    RUN_TEST(test_U1_042_Capabilities);
+    
+    // Framebuffer (U1-043, U1-044)
+    RUN_TEST(test_U1_043_FrameBufferFill);
+    RUN_TEST(test_U1_044_FrameBufferDirtyRange);
+    
+    // Animation Timing (U1-045)
+    RUN_TEST(test_U1_045_AnimationClock);
+    
+    // Color Tables (U1-046)
+    RUN_TEST(test_U1_046_ColorTables);
+    
+    // Transitions (U1-047)
+    RUN_TEST(test_U1_047_Transition);
+    
+    // Staged PIXELS (U1-048)
+    RUN_TEST(test_U1_048_RejectedPixelsStaged);
+    
+    // Baud Rate Confirmation (U1-049)
+    RUN_TEST(test_U1_049_BaudConfirmFence);
+    
+    // Batch Summary on Overflow (U1-050)
+    RUN_TEST(test_U1_050_BatchSummaryOnOverflow);
+    
+    // Command Table Order and Registry Capacity (U1-051, U1-052)
+    RUN_TEST(test_U1_051_CommandTableOpcodeOrder);
+    RUN_TEST(test_U1_052_RegistryOverflowRefused);
+    
+    // Supported Baud Rates (U1-053)
+    RUN_TEST(test_U1_053_BaudRateList);
+    
+    // Unsigned Arguments (U1-054)
+    RUN_TEST(test_U1_054_NegativeZeroRejected);
+    
     return UNITY_END();
 }
\ No newline at end of file
@@ -65,6 +65,14 @@ export class BaseBoard {
     }
   }
 
+  /**
+   * Get serial baud rates the firmware accepts via BAUD negotiation
+   */
+  getSupportedBaudRates() {
+    const serial = this.config.serial || {};
+    return serial.supportedBaudRates || [serial.baudRate || 9600];
+  }
+
   /**
    * Check if sketch is supported
    */
@@ -69,6 +69,8 @@ export class CLIService {
       .option('-s, --second-color <color>', 'Second color for two-color blinking')
       .option('-i, --interval <ms>', 'Blink interval or rainbow speed in milliseconds', '500')
       .option('-r, --rainbow', 'Activate rainbow effect')
+      .option('--fade <ms>', 'Fade to --color over the given milliseconds (0-65535)')
+      .option('--baud <rate>', 'Negotiate a faster serial rate (see board.json supportedBaudRates)')
       .action(async (options) => {
         await this.handleLedCommand(options);
       });
@@ -159,6 +161,22 @@ export class CLIService {
       
       // Convert interval to number
       options.interval = parseInt(options.interval);
+      if (options.fade !== undefined) {
+        if (!/^\d+$/.test(options.fade) || Number(options.fade) > 65535) {
+          throw new Error(`Invalid fade duration ${options.fade}. Use 0-65535 milliseconds`);
+        }
+        options.fade = Number(options.fade);
+      }
+      
+      // Only rates the selected board's firmware supports may be negotiated
+      if (options.baud) {
+        options.baud = parseInt(options.baud);
+        const board = this.boardLoader.loadBoard(this.program.opts().board);
+        const rates = board.getSupportedBaudRates();
+        if (!rates.includes(options.baud)) {
+          throw new Error(`Unsupported baud rate ${options.baud} for ${board.name}. Supported: ${rates.join(', ')}`);
+        }
+      }
       
       await this.controller.executeCommand(options);
       this.consoleHandler.log(chalk.green('✓ Command executed successfully'));
@@ -377,7 +395,9 @@ export class CLIService {
       .option('-b, --blink [color]', 'Blink mode')
       .option('-s, --second-color <color>', 'Second color')
       .option('-i, --interval <ms>', 'Interval', '500')
-      .option('-r, --rainbow', 'Rainbow effect');
+      .option('-r, --rainbow', 'Rainbow effect')
+      .option('--fade <ms>', 'Fade duration')
+      .option('--baud <rate>', 'Serial rate');
 
     program
       .command('compile <sketch>')
@@ -1,5 +1,13 @@
 import { SerialPort } from 'serialport';
 import { getSerialPort } from './utils/config.js';
+import {
+  FRAME_COMMANDS,
+  TEXT_ONLY_OPCODES,
+  encodeCommandFrame,
+  decodeResponseFrame,
+  encodeReliableCommandFrame,
+  decodeReliableResponseFrame
+} from './utils/frame-codec.js';
 
 /**
  * Color definitions
@@ -14,14 +22,132 @@ const COLORS = {
   white: '255,255,255'
 };
 
+/**
+ * Maximum commands per batch line (firmware COMMAND_BATCH_MAX)
+ */
+const MAX_BATCH_COMMANDS = 32;
+
+/**
+ * Sequence tags wrap after this value (firmware SEQUENCE_TAG_MAX)
+ */
+const MAX_SEQUENCE_TAG = 65535;
+
+/**
+ * Default number of tagged commands in flight for sendPipelined()
+ */
+const DEFAULT_PIPELINE_WINDOW = 4;
+
+/**
+ * Quiet-mode commands remembered for mapping REJECT sequence numbers back
+ */
+const QUIET_HISTORY_SIZE = 256;
+
+/**
+ * Session and link commands the device answers in quiet mode; they do not
+ * advance its sequence count (firmware quietExempt())
+ */
+const QUIET_EXEMPT_VERBS = new Set(['QUIET', 'STATS', 'BAUD', 'PING', 'FLOW', 'RELIABLE', 'CAPS']);
+
+/**
+ * Flow control credits a line costs: one per command, so one per batch item
+ * @param {string} line - Command line without newline
+ * @returns {number} Credits
+ */
+function creditCost(line) {
+  return line.split(';').length;
+}
+
+/**
+ * Link rate at power-up (firmware SERIAL_DEFAULT_BAUD)
+ */
+const DEFAULT_BAUD_RATE = 9600;
+
+/**
+ * PIXELS payload limit assumed until STATS reports payload_max
+ * (firmware PAYLOAD_MAX_BYTES on the smallest board)
+ */
+const DEFAULT_PAYLOAD_MAX = 256;
+
+/**
+ * Payload bytes per PIXELS pixel (RRGGBB) and the highest pixel index
+ */
+const PIXEL_BYTES = 3;
+const MAX_PIXEL_INDEX = 65535;
+
+/**
+ * FADE limits: longest duration, and easing names by wire value
+ */
+const MAX_FADE_DURATION = 65535;
+const EASING_CURVES = ['linear', 'ease-in', 'ease-out', 'ease-in-out'];
+
+/**
+ * Reliable mode: time to wait for a frame's acknowledgement before resending
+ * it, and resends allowed per frame before giving up
+ */
+const DEFAULT_RETRANSMIT_TIMEOUT = 250;
+const MAX_RETRANSMITS = 8;
+
+/**
+ * Device capabilities (CAPS) by port path, shared by every controller on
+ * that port so the query runs once per process
+ */
+const capabilityCache = new Map();
+
+/**
+ * What firmware that predates CAPS is assumed to run: the original verbs
+ * at the power-up rate
+ */
+const LEGACY_CAPABILITIES = {
+  protocol: 0,
+  led: 'legacy',
+  pixels: 1,
+  rxSize: 64,
+  baudMax: DEFAULT_BAUD_RATE,
+  verbs: new Set(['ON', 'OFF', 'COLOR', 'BLINK1', 'BLINK2', 'RAINBOW'])
+};
+
+/**
+ * Verb names whose opcode bit is set in a CAPS verbs mask
+ * @param {number} mask - Bit n set: opcode n runs natively
+ * @returns {Set<string>} Verb names
+ */
+function verbsFromMask(mask) {
+  const opcodes = { ...TEXT_ONLY_OPCODES };
+  for (const [verb, { opcode }] of Object.entries(FRAME_COMMANDS)) opcodes[verb] = opcode;
+  return new Set(Object.keys(opcodes).filter((verb) => (mask >>> opcodes[verb]) & 1));
+}
+
 /**
  * LED Controller class for Arduino boards
  */
 export class LedController {
   constructor(port, options = {}) {
     this.portName = port || getSerialPort();
-    this.baudRate = options.baudRate || 9600;
+    this.baudRate = options.baudRate || DEFAULT_BAUD_RATE;
+    // 'text' (default) or 'binary' (COBS/CRC-8 frames, see utils/frame-codec.js)
+    this.framing = options.framing || 'text';
     this.serialPort = null;
+    this.nextTag = 0;
+    // Quiet mode: called as onReject(response, command) for each REJECT line
+    this.onReject = options.onReject || null;
+    this.quietSequence = 0;
+    this.quietHistory = new Map();
+    this.quietHandler = null;
+    // Flow control: commands may be sent only while credits are held
+    this.flowControl = false;
+    this.credits = 0;
+    this.creditWaiters = [];
+    this.creditHandler = null;
+    // Largest PIXELS payload per command, updated from STATS
+    this.payloadMax = options.payloadMax || DEFAULT_PAYLOAD_MAX;
+    // Reliable mode: sequenced frames, resent on NAK or timeout
+    this.reliable = false;
+    this.reliableWindow = 1;
+    this.nextSequence = 0;
+    this.retransmitTimeout = options.retransmitTimeout || DEFAULT_RETRANSMIT_TIMEOUT;
+    this.retransmits = 0;
+    // Set by getCapabilities(); commands the device lacks are refused locally
+    this.capabilities = capabilityCache.get(this.portName) || null;
     // Always use Universal protocol - Arduino handles conversion internally
   }
 
@@ -51,6 +177,17 @@ export class LedController {
     if (!this.serialPort || !this.serialPort.isOpen) {
       throw new Error('Serial port is not open. Call connect() first.');
     }
+    this.checkSupported(command);
+
+    if (this.reliable) {
+      await this.sendReliable([command]);
+      return;
+    }
+
+    await this.acquireCredits(creditCost(command));
+    if (this.framing === 'binary') {
+      return this.sendFrame(command);
+    }
 
     return new Promise((resolve, reject) => {
       console.log(`Sent command: ${command}`);
@@ -65,8 +202,10 @@ export class LedController {
       }, process.env.NODE_ENV === 'test' ? 10 : 2000);
       
       const responseHandler = (data) => {
-        const response = data.toString().trim();
-        if (response.startsWith('ACCEPTED,') || response.startsWith('REJECT,')) {
+        // Other lines (e.g. CREDIT) may share the chunk with the response
+        const response = data.toString().split('\n').map((line) => line.trim())
+          .find((line) => line.startsWith('ACCEPTED,') || line.startsWith('REJECT,'));
+        if (response) {
           responseReceived = true;
           clearTimeout(responseTimeout);
           console.log(`Device response: ${response}`);
@@ -87,6 +226,60 @@ export class LedController {
     });
   }
 
+  /**
+   * Send command as a binary frame and wait for the response frame
+   * @param {string} command - Text command, translated to its binary form
+   */
+  async sendFrame(command) {
+    const frame = encodeCommandFrame(command);
+
+    return new Promise((resolve, reject) => {
+      console.log(`Sent command: ${command} (binary)`);
+
+      let received = null;  // Bytes of the frame being read, null before its opening delimiter
+      const responseTimeout = setTimeout(() => {
+        console.log('No response received from device (timeout)');
+        this.serialPort.off('data', responseHandler);
+        resolve();
+      }, process.env.NODE_ENV === 'test' ? 10 : 2000);
+
+      // Frames open and close with 0x00; text ahead of the frame (e.g. a
+      // CREDIT line or a quiet-mode REJECT) is skipped, as in sendReliable()
+      const responseHandler = (data) => {
+        for (const byte of data) {
+          if (byte !== 0x00) {
+            if (received) received.push(byte);
+            continue;
+          }
+          if (!received || received.length === 0) {
+            received = [];
+            continue;
+          }
+
+          clearTimeout(responseTimeout);
+          this.serialPort.off('data', responseHandler);
+          try {
+            console.log(`Device response: ${decodeResponseFrame(received).text}`);
+            resolve();
+          } catch (err) {
+            reject(err);
+          }
+          return;
+        }
+      };
+
+      this.serialPort.on('data', responseHandler);
+
+      this.serialPort.write(frame, (err) => {
+        if (err) {
+          clearTimeout(responseTimeout);
+          this.serialPort.off('data', responseHandler);
+          reject(new Error(`Failed to send command: ${err.message}`));
+        }
+      });
+    });
+  }
+
   /**
    * Close serial connection
    */
@@ -100,6 +293,68 @@ export class LedController {
     }
   }
 
+  /**
+   * Check the link with a tagged PING
+   * @returns {Promise<boolean>} true if the device answered
+   */
+  async ping() {
+    const [response] = await this.sendPipelined(['PING'], { window: 1 });
+    return Boolean(response && response.startsWith('ACCEPTED,'));
+  }
+
+  /**
+   * Negotiate a new link rate. The device acknowledges BAUD at the current
+   * rate and switches; both sides then confirm with PING at the new rate.
+   * If that fails the host returns to the old rate, which the device also
+   * falls back to when no valid command reaches it within one second.
+   * @param {number} rate - Proposed baud rate (see board.json supportedBaudRates)
+   * @returns {Promise<boolean>} true if the link now runs at rate
+   * @throws {Error} If the device no longer answers at either rate
+   */
+  async negotiateBaudRate(rate) {
+    if (rate === this.baudRate) return true;
+    const previousRate = this.baudRate;
+    if (this.capabilities && rate > this.capabilities.baudMax) {
+      console.log(`Baud rate ${rate} above device maximum ${this.capabilities.baudMax}, staying at ${previousRate}`);
+      return false;
+    }
+
+    const [ack] = await this.sendPipelined([`BAUD,${rate}`], { window: 1 });
+    if (!ack || !ack.startsWith('ACCEPTED,')) {
+      console.log(`Baud rate ${rate} refused, staying at ${previousRate}`);
+      return false;
+    }
+
+    await this.updateBaudRate(rate);
+    if (await this.ping()) return true;
+
+    // The failed PING outlasts the device's confirmation window, so it is
+    // already back at the old rate
+    await this.updateBaudRate(previousRate);
+    if (!(await this.ping())) {
+      throw new Error(`Device not responding after baud rate change to ${rate}`);
+    }
+    console.log(`Baud rate ${rate} not confirmed, staying at ${previousRate}`);
+    return false;
+  }
+
+  /**
+   * Change the host side of the link without reopening the port
+   * @param {number} rate - Baud rate
+   */
+  async updateBaudRate(rate) {
+    await new Promise((resolve, reject) => {
+      this.serialPort.update({ baudRate: rate }, (err) => {
+        if (err) {
+          reject(new Error(`Failed to set baud rate ${rate}: ${err.message}`));
+        } else {
+          resolve();
+        }
+      });
+    });
+    this.baudRate = rate;
+  }
+
   /**
    * Turn LED on (white or default color)
    */
@@ -132,9 +387,10 @@ export class LedController {
     if (interval <= 0) {
       throw new Error('Invalid interval');
     }
-    const rgb = this.parseColor(color);
-    if (this.protocol === 'Digital' && color && color !== 'white') {
-      console.log(`Note: Digital LED does not support colors. Color '${color}' ignored, blinking LED.`);
+    let rgb = this.parseColor(color);
+    if (this.capabilities && !this.capabilities.verbs.has('COLOR') && rgb !== COLORS.white) {
+      console.log(`Note: ${this.capabilities.led} LED does not support colors. Color '${color}' ignored, blinking LED.`);
+      rgb = COLORS.white;
     }
     await this.sendCommand(`BLINK1,${rgb},${interval}`);
   }
@@ -159,6 +415,577 @@ export class LedController {
     await this.sendCommand(`RAINBOW,${interval}`);
   }
 
+  /**
+   * Set individual pixels of a strip. Pixels travel as one PIXELS command per
+   * payloadMax bytes (a whole strip in one command on most boards) and each
+   * command's pixels are shown together once its payload has arrived.
+   * Text framing only.
+   * @param {string[]} colors - Color names or RGB strings, one per pixel
+   * @param {number} start - Index of the first pixel
+   */
+  async setPixels(colors, start = 0) {
+    if (!Array.isArray(colors) || colors.length === 0) {
+      throw new Error('At least one pixel color is required');
+    }
+    const lastPixel = this.capabilities ? this.capabilities.pixels - 1 : MAX_PIXEL_INDEX;
+    if (!Number.isInteger(start) || start < 0 || start + colors.length - 1 > lastPixel) {
+      throw new Error(`Invalid pixel range: ${start}..${start + colors.length - 1}`);
+    }
+
+    const hex = colors.map((color) => this.parseColor(color).split(',')
+      .map((value) => Number(value).toString(16).padStart(2, '0').toUpperCase()).join(''));
+    const perCommand = Math.max(1, Math.floor(this.payloadMax / PIXEL_BYTES));
+    for (let i = 0; i < hex.length; i += perCommand) {
+      await this.sendCommand(`PIXELS,${start + i},${hex.slice(i, i + perCommand).join('')}`);
+    }
+  }
+
+  /**
+   * Set a run of pixels to one color and show the strip. The device clips
+   * the run to its strip, so the default count covers every remaining pixel.
+   * @param {string} color - Color name or RGB string
+   * @param {number} start - Index of the first pixel
+   * @param {number} [count] - Pixels to set (default: through the end of the strip)
+   */
+  async fill(color, start = 0, count) {
+    const lastPixel = this.capabilities ? this.capabilities.pixels - 1 : MAX_PIXEL_INDEX;
+    const run = count === undefined ? Math.min(lastPixel - start + 1, MAX_PIXEL_INDEX) : count;
+    if (!Number.isInteger(start) || start < 0 || start > lastPixel ||
+        !Number.isInteger(run) || run < 1 || run > MAX_PIXEL_INDEX) {
+      throw new Error(`Invalid pixel range: ${start}..${start + run - 1}`);
+    }
+    const rgb = this.parseColor(color);
+    await this.sendCommand(`FILL,${start},${run},${rgb}`);
+  }
+
+  /**
+   * Crossfade the whole strip from what it shows now to a color. The device
+   * interpolates every frame itself, so one command replaces a stream of
+   * COLOR steps.
+   * @param {string} color - Target color name or RGB string
+   * @param {number} duration - Fade time in milliseconds (0-65535)
+   * @param {string} easing - 'linear', 'ease-in', 'ease-out' or 'ease-in-out'
+   */
+  async fade(color, duration = 500, easing = 'linear') {
+    if (!Number.isInteger(duration) || duration < 0 || duration > MAX_FADE_DURATION) {
+      throw new Error(`Invalid fade duration: ${duration}`);
+    }
+    const curve = EASING_CURVES.indexOf(easing);
+    if (curve < 0) {
+      throw new Error(`Invalid easing: ${easing} (use ${EASING_CURVES.join(', ')})`);
+    }
+    const rgb = this.parseColor(color);
+    await this.sendCommand(`FADE,${rgb},${duration},${curve}`);
+  }
+
+  /**
+   * Switch the device between full and compact acknowledgements
+   * Compact mode echoes only the verb (ACCEPTED,COLOR), halving response bytes
+   * @param {boolean} enabled - true for compact echo, false for full echo
+   */
+  async setCompactEcho(enabled = true) {
+    await this.sendCommand(`ECHO,${enabled ? 0 : 1}`);
+  }
+
+  /**
+   * Switch the device in or out of quiet mode. In quiet mode accepted
+   * commands are not acknowledged and REJECT lines carry the sequence number
+   * of the failing command; use sendNoWait() while quiet mode is on.
+   * @param {boolean} enabled - true to enable quiet mode
+   */
+  async setQuietMode(enabled = true) {
+    await this.sendCommand(`QUIET,${enabled ? 1 : 0}`);
+
+    if (this.quietHandler) {
+      this.serialPort.off('data', this.quietHandler);
+      this.quietHandler = null;
+    }
+    this.quietSequence = 0;
+    this.quietHistory.clear();
+    if (!enabled) return;
+
+    let partial = '';
+    this.quietHandler = (data) => {
+      const lines = (partial + data.toString()).split('\n');
+      partial = lines.pop();
+      for (const raw of lines) {
+        const response = raw.trim();
+        const match = /^REJECT,#(\d+),/.exec(response);
+        if (!match) continue;
+        const command = this.quietHistory.get(Number(match[1])) || null;
+        if (this.onReject) {
+          this.onReject(response, command);
+        } else {
+          console.log(`Device response: ${response}${command ? ` (${command})` : ''}`);
+        }
+      }
+    };
+    this.serialPort.on('data', this.quietHandler);
+  }
+
+  /**
+   * Send a command without waiting for a response (quiet mode)
+   * Resolves once the bytes are handed to the serial port.
+   * @param {string} command - Command to send
+   */
+  async sendNoWait(command) {
+    if (!this.serialPort || !this.serialPort.isOpen) {
+      throw new Error('Serial port is not open. Call connect() first.');
+    }
+
+    this.checkSupported(command);
+
+    // Mirror the device's counter so a REJECT can be traced to its command.
+    // A batch counts once, under its last verb, as its summary line does.
+    const verb = command.replace(/^#\d+,/, '').split(';').pop().split(',')[0].trim();
+    if (!QUIET_EXEMPT_VERBS.has(verb)) {
+      this.quietSequence = (this.quietSequence + 1) % (MAX_SEQUENCE_TAG + 1);
+      this.quietHistory.set(this.quietSequence, command);
+      if (this.quietHistory.size > QUIET_HISTORY_SIZE) {
+        this.quietHistory.delete(this.quietHistory.keys().next().value);
+      }
+    }
+
+    await this.acquireCredits(creditCost(command));
+    return new Promise((resolve, reject) => {
+      this.serialPort.write(`${command}\n`, (err) => {
+        if (err) {
+          reject(new Error(`Failed to send command: ${err.message}`));
+        } else {
+          resolve();
+        }
+      });
+    });
+  }
+
+  /**
+   * Switch credit-based flow control on or off. While on, each command (each
+   * batch item) spends one credit and the device returns credits in
+   * CREDIT,<n> lines as it frees queue slots, so commands can be streamed
+   * back-to-back (e.g. sendNoWait() in quiet mode) without overrunning it.
+   * @param {boolean} enabled - true to enable flow control
+   */
+  async setFlowControl(enabled = true) {
+    if (enabled === this.flowControl) return;
+
+    if (enabled) {
+      // Listen first: the initial grant follows the FLOW,1 acknowledgement
+      this.credits = 0;
+      let partial = '';
+      this.creditHandler = (data) => {
+        const lines = (partial + data.toString()).split('\n');
+        partial = lines.pop();
+        for (const raw of lines) {
+          const match = /^CREDIT,(\d+)/.exec(raw.trim());
+          if (match) this.grantCredits(Number(match[1]));
+        }
+      };
+      this.serialPort.on('data', this.creditHandler);
+      await this.sendPipelined(['FLOW,1'], { window: 1 });
+      this.flowControl = true;
+    } else {
+      await this.sendPipelined(['FLOW,0'], { window: 1 });
+      this.flowControl = false;
+      this.serialPort.off('data', this.creditHandler);
+      this.creditHandler = null;
+      this.grantCredits(0);  // Wake anything still waiting
+    }
+  }
+
+  /**
+   * Add credits from the device and wake waiting senders
+   * @param {number} count - Credits granted
+   */
+  grantCredits(count) {
+    this.credits += count;
+    const waiters = this.creditWaiters;
+    this.creditWaiters = [];
+    waiters.forEach((wake) => wake());
+  }
+
+  /**
+   * Spend credits if enough are held (always succeeds without flow control)
+   * @param {number} count - Credits needed
+   * @returns {boolean} true if the command may be sent now
+   */
+  takeCredits(count) {
+    if (!this.flowControl) return true;
+    if (this.credits < count) return false;
+    this.credits -= count;
+    return true;
+  }
+
+  /**
+   * Wait until count credits can be spent
+   * @param {number} count - Credits needed
+   * @throws {Error} If the device grants none before the response timeout
+   */
+  async acquireCredits(count) {
+    const timeoutMs = process.env.NODE_ENV === 'test' ? 10 : 2000;
+    while (!this.takeCredits(count)) {
+      await new Promise((resolve, reject) => {
+        const timer = setTimeout(() => {
+          this.creditWaiters = this.creditWaiters.filter((wake) => wake !== onCredit);
+          reject(new Error('No flow control credit from device (timeout)'));
+        }, timeoutMs);
+        const onCredit = () => {
+          clearTimeout(timer);
+          resolve();
+        };
+        this.creditWaiters.push(onCredit);
+      });
+    }
+  }
+
+  /**
+   * Send commands with #<id> sequence tags, keeping up to `window` of them in
+   * flight and matching each ACCEPTED/REJECT line to its command by tag
+   * @param {string[]} commands - Text commands
+   * @param {object} [options]
+   * @param {number} [options.window=4] - Maximum outstanding commands
+   * @param {boolean} [options.untagged=false] - Also settle the oldest
+   *   outstanding command with an untagged ACCEPTED/REJECT line, as firmware
+   *   that predates sequence tags answers
+   * @returns {Promise<Array<string|null>>} Response per command, null on timeout
+   */
+  async sendPipelined(commands, options = {}) {
+    if (!this.serialPort || !this.serialPort.isOpen) {
+      throw new Error('Serial port is not open. Call connect() first.');
+    }
+    commands.forEach((command) => this.checkSupported(command));
+    const windowSize = options.window || DEFAULT_PIPELINE_WINDOW;
+    const timeoutMs = process.env.NODE_ENV === 'test' ? 10 : 2000;
+
+    return new Promise((resolve, reject) => {
+      const results = new Array(commands.length).fill(null);
+      const outstanding = new Map();  // tag -> { index, timer }
+      let nextIndex = 0;
+      let settled = 0;
+      let partial = '';
+      let creditTimer = null;
+
+      const finish = (error) => {
+        for (const { timer } of outstanding.values()) clearTimeout(timer);
+        outstanding.clear();
+        clearTimeout(creditTimer);
+        this.creditWaiters = this.creditWaiters.filter((wake) => wake !== fill);
+        this.serialPort.off('data', responseHandler);
+        if (error) {
+          reject(error);
+        } else {
+          resolve(results);
+        }
+      };
+
+      const settle = (tag, response) => {
+        const entry = outstanding.get(tag);
+        if (!entry) return;
+        clearTimeout(entry.timer);
+        outstanding.delete(tag);
+        results[entry.index] = response;
+        if (response) {
+          console.log(`Device response: ${response}`);
+        } else {
+          console.log(`No response received for #${tag} (timeout)`);
+        }
+        settled++;
+        fill();
+      };
+
+      // Keep the window full; resolve once every command has settled
+      const fill = () => {
+        clearTimeout(creditTimer);
+        while (outstanding.size < windowSize && nextIndex < commands.length) {
+          // Without credits, resume when the device grants more
+          if (!this.takeCredits(creditCost(commands[nextIndex]))) {
+            this.creditWaiters.push(fill);
+            if (outstanding.size === 0) {
+              creditTimer = setTimeout(() => finish(new Error('No flow control credit from device (timeout)')), timeoutMs);
+            }
+            break;
+          }
+          const index = nextIndex++;
+          const tag = this.nextTag;
+          this.nextTag = tag === MAX_SEQUENCE_TAG ? 0 : tag + 1;
+
+          const line = `#${tag},${commands[index]}`;
+          const timer = setTimeout(() => settle(tag, null), timeoutMs);
+          outstanding.set(tag, { index, timer });
+          console.log(`Sent command: ${line}`);
+          this.serialPort.write(`${line}\n`, (err) => {
+            if (err) finish(new Error(`Failed to send command: ${err.message}`));
+          });
+        }
+        if (settled === commands.length) finish();
+      };
+
+      // Responses may arrive split or coalesced; match complete lines by tag
+      const responseHandler = (data) => {
+        const lines = (partial + data.toString()).split('\n');
+        partial = lines.pop();
+        for (const raw of lines) {
+          const response = raw.trim();
+          const match = /^(?:ACCEPTED|REJECT),#(\d+),/.exec(response);
+          if (match) settle(Number(match[1]), response);
+        }
+        // Untagged firmware may also leave the line unterminated, as
+        // sendCommand() allows
+        if (options.untagged && outstanding.size > 0) {
+          const response = [...lines, partial].map((line) => line.trim())
+            .find((line) => /^(?:ACCEPTED|REJECT),[^#]/.test(line));
+          if (response) {
+            if (response === partial.trim()) partial = '';
+            settle(outstanding.keys().next().value, response);
+          }
+        }
+      };
+
+      this.serialPort.on('data', responseHandler);
+      fill();
+    });
+  }
+
+  /**
+   * Switch reliable mode (RELIABLE) on or off. While on, sendCommand() and
+   * sendReliable() send sequenced binary frames; both ends restart the
+   * sequence at 0.
+   * @param {boolean} enabled - true to enable reliable mode
+   * @returns {Promise<number>} Frames the device holds past a gap (window)
+   * @throws {Error} If the device does not accept the command
+   */
+  async setReliableMode(enabled = true) {
+    const [response] = await this.sendPipelined([`RELIABLE,${enabled ? 1 : 0}`], { window: 1 });
+    if (!response || !response.startsWith('ACCEPTED,')) {
+      throw new Error(`Reliable mode not accepted: ${response || 'no response'}`);
+    }
+
+    const match = /,window=(\d+)/.exec(response);
+    this.reliableWindow = match ? Number(match[1]) : 1;
+    this.nextSequence = 0;
+    this.reliable = enabled;
+    return this.reliableWindow;
+  }
+
+  /**
+   * Send commands as sequenced frames in reliable mode, keeping up to the
+   * device's window of them in flight. A frame is resent when the device
+   * NAKs it or no acknowledgement arrives within retransmitTimeout; the
+   * device holds frames received past a gap, so only lost frames are resent.
+   * Reliable frames bypass the command queue and cost no flow control credits.
+   * @param {string[]} commands - Text commands with a binary form
+   * @param {object} [options]
+   * @param {number} [options.window] - Maximum frames in flight (at most the device window)
+   * @returns {Promise<string[]>} Response per command
+   * @throws {Error} If a frame is still unacknowledged after MAX_RETRANSMITS resends
+   */
+  async sendReliable(commands, options = {}) {
+    if (!this.serialPort || !this.serialPort.isOpen) {
+      throw new Error('Serial port is not open. Call connect() first.');
+    }
+    if (!this.reliable) {
+      throw new Error('Reliable mode is off. Call setReliableMode() first.');
+    }
+    commands.forEach((command) => {
+      this.checkSupported(command);
+      encodeCommandFrame(command);  // Reject commands without a binary form up front
+    });
+    const windowSize = Math.min(options.window || this.reliableWindow, this.reliableWindow);
+    const timeoutMs = process.env.NODE_ENV === 'test' ? 10 : this.retransmitTimeout;
+
+    return new Promise((resolve, reject) => {
+      const results = new Array(commands.length).fill(null);
+      const inFlight = new Map();  // sequence -> { index, frame, sends, timer }
+      let nextIndex = 0;
+      let acknowledged = 0;
+      let received = null;  // Bytes of the frame being read, null between frames
+
+      const finish = (error) => {
+        for (const { timer } of inFlight.values()) clearTimeout(timer);
+        inFlight.clear();
+        this.serialPort.off('data', responseHandler);
+        if (error) {
+          reject(error);
+        } else {
+          resolve(results);
+        }
+      };
+
+      const transmit = (sequence) => {
+        const entry = inFlight.get(sequence);
+        if (!entry) return;
+        if (entry.sends > MAX_RETRANSMITS) {
+          finish(new Error(`No acknowledgement for ${commands[entry.index]} after ${MAX_RETRANSMITS} retransmissions`));
+          return;
+        }
+        if (entry.sends > 0) {
+          this.retransmits++;
+          console.log(`Resent command: ${commands[entry.index]} (seq ${sequence})`);
+        }
+        entry.sends++;
+        clearTimeout(entry.timer);
+        entry.timer = setTimeout(() => transmit(sequence), timeoutMs);
+        this.serialPort.write(entry.frame, (err) => {
+          if (err) finish(new Error(`Failed to send command: ${err.message}`));
+        });
+      };
+
+      // The device acknowledges in sequence order, so the frames in flight
+      // never span more than the window
+      const fill = () => {
+        while (inFlight.size < windowSize && nextIndex < commands.length) {
+          const index = nextIndex++;
+          const sequence = this.nextSequence;
+          this.nextSequence = (sequence + 1) & 0xFF;
+          inFlight.set(sequence, {
+            index,
+            frame: encodeReliableCommandFrame(commands[index], sequence),
+            sends: 0,
+            timer: null
+          });
+          console.log(`Sent command: ${commands[index]} (seq ${sequence})`);
+          transmit(sequence);
+        }
+        if (acknowledged === commands.length) finish();
+      };
+
+      const handleFrame = (bytes) => {
+        let response;
+        try {
+          response = decodeReliableResponseFrame(bytes);
+        } catch {
+          return;  // Corrupt acknowledgement: the retransmit timer covers it
+        }
+        const entry = inFlight.get(response.sequence);
+        if (!entry) return;
+        if (response.nak) {
+          transmit(response.sequence);
+          return;
+        }
+        clearTimeout(entry.timer);
+        inFlight.delete(response.sequence);
+        results[entry.index] = response.text;
+        console.log(`Device response: ${response.text}`);
+        acknowledged++;
+        fill();
+      };
+
+      // Frames open and close with 0x00; bytes between frames (e.g. CREDIT
+      // lines) are skipped. An empty frame means a delimiter was taken for
+      // the wrong one, so the reader is already inside the next frame.
+      const responseHandler = (data) => {
+        for (const byte of data) {
+          if (byte !== 0x00) {
+            if (received) received.push(byte);
+          } else if (!received || received.length === 0) {
+            received = [];
+          } else {
+            const bytes = received;
+            received = null;
+            handleFrame(bytes);
+          }
+        }
+      };
+
+      this.serialPort.on('data', responseHandler);
+      fill();
+    });
+  }
+
+  /**
+   * Query what the device supports (CAPS), cached per port. Once known,
+   * commands the LED would down-convert or reject are refused before they
+   * are sent (see checkSupported()). Firmware that rejects CAPS, answers
+   * untagged or does not answer is taken to run only the original verbs
+   * (protocol 0).
+   * @param {object} [options]
+   * @param {boolean} [options.refresh=false] - Ask the device even if cached
+   * @returns {Promise<{protocol: number, led: string, pixels: number, rxSize: number,
+   *   baudMax: number, verbs: Set<string>}>} Capabilities
+   */
+  async getCapabilities(options = {}) {
+    if (!options.refresh && capabilityCache.has(this.portName)) {
+      this.capabilities = capabilityCache.get(this.portName);
+      return this.capabilities;
+    }
+
+    this.capabilities = null;
+    const [response] = await this.sendPipelined(['CAPS'], { window: 1, untagged: true });
+    if (!response || !/^ACCEPTED,#\d+,CAPS,/.test(response)) {
+      this.capabilities = LEGACY_CAPABILITIES;
+      capabilityCache.set(this.portName, this.capabilities);
+      return this.capabilities;
+    }
+
+    const fields = {};
+    for (const field of response.split(',')) {
+      const [name, value] = field.split('=');
+      if (value !== undefined) fields[name] = value;
+    }
+    this.capabilities = {
+      protocol: Number(fields.proto),
+      led: fields.led,
+      pixels: Number(fields.pixels),
+      rxSize: Number(fields.rx),
+      baudMax: Number(fields.baud_max),
+      verbs: verbsFromMask(parseInt(fields.verbs, 16))
+    };
+    capabilityCache.set(this.portName, this.capabilities);
+    return this.capabilities;
+  }
+
+  /**
+   * Refuse a command line the device does not run natively. Passes
+   * everything until capabilities are known.
+   * @param {string} line - Command, batch or tagged line without newline
+   * @throws {Error} If a verb is not in the device's CAPS verbs
+   */
+  checkSupported(line) {
+    if (!this.capabilities) return;
+    for (const command of line.replace(/^#\d+,/, '').split(';')) {
+      const verb = command.split(',')[0].trim();
+      if (!this.capabilities.verbs.has(verb)) {
+        throw new Error(`${verb} is not supported by this device (${this.capabilities.led} LED)`);
+      }
+    }
+  }
+
+  /**
+   * Query the device's transport counters (STATS). Answered even in quiet mode.
+   * @returns {Promise<Object<string, number>|null>} Counters by name
+   *   (tx_high, tx_size, tx_stalls, payload_max, naks, dups, shows, skips), or null if the device did
+   *   not answer. payload_max also sizes later setPixels() commands.
+   */
+  async getStats() {
+    const [response] = await this.sendPipelined(['STATS'], { window: 1 });
+    if (!response || !response.startsWith('ACCEPTED,')) return null;
+
+    const stats = {};
+    for (const field of response.split(',')) {
+      const [name, value] = field.split('=');
+      if (value !== undefined) stats[name] = Number(value);
+    }
+    if (stats.payload_max > 0) this.payloadMax = stats.payload_max;
+    return stats;
+  }
+
+  /**
+   * Send several commands in one line; the device runs them in order and
+   * answers once with ACCEPTED|REJECT,BATCH,<count>,<status bits>
+   * @param {string[]} commands - Text commands, e.g. ['OFF', 'COLOR,255,0,0']
+   */
+  async sendBatch(commands) {
+    if (!Array.isArray(commands) || commands.length === 0) {
+      throw new Error('Batch must contain at least one command');
+    }
+    if (commands.length > MAX_BATCH_COMMANDS) {
+      throw new Error(`Batch too large: ${commands.length} commands (max ${MAX_BATCH_COMMANDS})`);
+    }
+    if (commands.some((command) => /[;\n]/.test(command))) {
+      throw new Error('Batch commands must not contain separators or newlines');
+    }
+    await this.sendCommand(commands.join(';'));
+  }
+
   /**
    * Parse color input to RGB string
    * @param {string} color - Color name or RGB string
@@ -191,12 +1018,21 @@ export class LedController {
  */
 export async function executeCommand(options) {
   const controller = new LedController(options.port, {
-    baudRate: 9600  // Universal protocol uses standard 9600 baud rate
+    baudRate: DEFAULT_BAUD_RATE  // Universal protocol starts at 9600 baud
   });
   
   try {
     await controller.connect();
     
+    // Learn once per port what the device runs, so verbs it lacks are refused
+    // here instead of being rejected or down-converted by the device
+    await controller.getCapabilities();
+    
+    // Optional faster link; the command still runs at the old rate on fallback
+    if (options.baud) {
+      await controller.negotiateBaudRate(options.baud);
+    }
+    
     // Command priority: on/off > blink > rainbow > color
     if (options.on) {
       await controller.turnOn();
@@ -216,6 +1052,8 @@ export async function executeCommand(options) {
       }
     } else if (options.rainbow) {
       await controller.rainbow(options.interval);
+    } else if (options.color && options.fade !== undefined) {
+      await controller.fade(options.color, options.fade);
     } else if (options.color) {
       await controller.setColor(options.color);
     } else {
@@ -0,0 +1,231 @@
+/**
+ * @fileoverview Binary Frame Codec
+ *
+ * Host side of the optional binary protocol (sketches/common/src/FrameCodec.h).
+ * Each frame is 0x00, COBS(payload + CRC-8), 0x00. Command payloads carry the
+ * opcode followed by fixed-width little-endian arguments; response payloads
+ * carry the opcode and a status code. In reliable mode (RELIABLE,1) both
+ * directions prefix the payload with a sequence number and seed the CRC with
+ * the payload length, so frames merged by a lost delimiter are rejected.
+ */
+
+const FRAME_DELIMITER = 0x00;
+
+/**
+ * Opcodes and argument byte widths, mirroring the firmware command table
+ * (PIXELS, opcode 13, is text-only)
+ */
+export const FRAME_COMMANDS = {
+  ON:      { opcode: 1, widths: [] },
+  OFF:     { opcode: 2, widths: [] },
+  COLOR:   { opcode: 3, widths: [1, 1, 1] },
+  BLINK1:  { opcode: 4, widths: [1, 1, 1, 4] },
+  BLINK2:  { opcode: 5, widths: [1, 1, 1, 1, 1, 1, 4] },
+  RAINBOW: { opcode: 6, widths: [4] },
+  ECHO:    { opcode: 7, widths: [1] },
+  QUIET:   { opcode: 8, widths: [1] },
+  STATS:   { opcode: 9, widths: [] },
+  BAUD:    { opcode: 10, widths: [4] },
+  PING:    { opcode: 11, widths: [] },
+  FLOW:    { opcode: 12, widths: [1] },
+  RELIABLE: { opcode: 14, widths: [1] },
+  CAPS:    { opcode: 15, widths: [] },
+  FILL:    { opcode: 16, widths: [2, 2, 1, 1, 1] },
+  FADE:    { opcode: 17, widths: [1, 1, 1, 2, 1] }
+};
+
+/**
+ * Opcodes of text-only commands, for decoding the CAPS verbs mask
+ */
+export const TEXT_ONLY_OPCODES = {
+  PIXELS: 13
+};
+
+/**
+ * Response status codes (firmware ParseError)
+ */
+export const FRAME_STATUS = {
+  0: 'ok',
+  1: 'unknown command',
+  2: 'invalid parameters',
+  3: 'bad frame',
+  4: 'payload too long'
+};
+
+/**
+ * CRC-8, polynomial 0x07, initial value 0x00 unless seeded
+ * @param {number[]|Uint8Array} bytes - Data to checksum
+ * @param {number} [seed=0] - Initial value
+ * @returns {number} CRC byte
+ */
+export function crc8(bytes, seed = 0) {
+  let crc = seed;
+  for (const byte of bytes) {
+    crc ^= byte;
+    for (let bit = 0; bit < 8; bit++) {
+      crc = crc & 0x80 ? ((crc << 1) ^ 0x07) & 0xFF : (crc << 1) & 0xFF;
+    }
+  }
+  return crc;
+}
+
+/**
+ * COBS-encode a payload (no delimiters)
+ * @param {number[]|Uint8Array} payload - Raw bytes
+ * @returns {number[]} Encoded bytes, free of 0x00
+ */
+export function cobsEncode(payload) {
+  const out = [0];
+  let codeIndex = 0;
+  let code = 1;
+
+  for (const byte of payload) {
+    if (byte !== 0) {
+      out.push(byte);
+      code++;
+    }
+    if (byte === 0 || code === 0xFF) {
+      out[codeIndex] = code;
+      codeIndex = out.length;
+      out.push(0);
+      code = 1;
+    }
+  }
+  out[codeIndex] = code;
+  return out;
+}
+
+/**
+ * Decode a COBS block sequence (no delimiters)
+ * @param {number[]|Uint8Array} encoded - Encoded bytes
+ * @returns {number[]} Decoded payload
+ * @throws {Error} If a block is truncated
+ */
+export function cobsDecode(encoded) {
+  const out = [];
+  let i = 0;
+
+  while (i < encoded.length) {
+    const code = encoded[i++];
+    if (code === 0 || i + code - 1 > encoded.length) {
+      throw new Error('Malformed COBS frame');
+    }
+    for (let n = 1; n < code; n++) {
+      out.push(encoded[i++]);
+    }
+    if (code !== 0xFF && i < encoded.length) {
+      out.push(0);
+    }
+  }
+  return out;
+}
+
+/**
+ * Opcode and little-endian arguments of a text protocol command
+ * @param {string} command - Text command
+ * @returns {number[]} Payload without CRC
+ * @throws {Error} If the verb has no binary form or the arity is wrong
+ */
+function commandPayload(command) {
+  const [verb, ...args] = command.trim().split(',');
+  const spec = FRAME_COMMANDS[verb];
+  if (!spec) {
+    throw new Error(`Unsupported binary command: ${verb}`);
+  }
+  if (args.length !== spec.widths.length) {
+    throw new Error(`Invalid argument count for ${verb}: ${command}`);
+  }
+
+  const payload = [spec.opcode];
+  spec.widths.forEach((width, index) => {
+    const value = Number(args[index]);
+    if (!Number.isInteger(value) || value < 0 || value >= 2 ** (8 * width)) {
+      throw new Error(`Invalid argument for ${verb}: ${args[index]}`);
+    }
+    for (let b = 0; b < width; b++) {
+      payload.push(Math.floor(value / 2 ** (8 * b)) & 0xFF);
+    }
+  });
+  return payload;
+}
+
+/**
+ * Wrap a payload in CRC-8, COBS and both delimiters
+ * @param {number[]} payload - Payload without CRC
+ * @param {number} [seed=0] - CRC initial value
+ * @returns {Buffer} Complete frame
+ */
+function frame(payload, seed = 0) {
+  return Buffer.from([FRAME_DELIMITER, ...cobsEncode([...payload, crc8(payload, seed)]), FRAME_DELIMITER]);
+}
+
+/**
+ * Encode a text protocol command (e.g. "COLOR,255,0,0") as a binary frame
+ * @param {string} command - Text command
+ * @returns {Buffer} Complete frame with both delimiters
+ * @throws {Error} If the verb has no binary form or the arity is wrong
+ */
+export function encodeCommandFrame(command) {
+  return frame(commandPayload(command));
+}
+
+/**
+ * Encode a command as a reliable-mode frame
+ * @param {string} command - Text command
+ * @param {number} sequence - Sequence number (0-255)
+ * @returns {Buffer} Complete frame with both delimiters
+ * @throws {Error} If the verb has no binary form or the arity is wrong
+ */
+export function encodeReliableCommandFrame(command, sequence) {
+  const payload = [sequence & 0xFF, ...commandPayload(command)];
+  return frame(payload, payload.length);
+}
+
+/**
+ * Decode a response frame body (delimiters already stripped)
+ * @param {number[]|Uint8Array} encoded - COBS bytes between delimiters
+ * @returns {{opcode: number, status: number, accepted: boolean, text: string}}
+ * @throws {Error} If the frame is malformed or fails its CRC
+ */
+export function decodeResponseFrame(encoded) {
+  const payload = cobsDecode(encoded);
+  if (payload.length !== 3 || crc8(payload.slice(0, 2)) !== payload[2]) {
+    throw new Error('Corrupt response frame');
+  }
+
+  const [opcode, status] = payload;
+  const verb = Object.keys(FRAME_COMMANDS).find((name) => FRAME_COMMANDS[name].opcode === opcode);
+  const accepted = status === 0;
+  const text = accepted
+    ? `ACCEPTED,${verb}`
+    : `REJECT,${verb || 'FRAME'},${FRAME_STATUS[status] || 'unknown error'}`;
+
+  return { opcode, status, accepted, text };
+}
+
+/**
+ * Decode a reliable-mode response frame body (delimiters already stripped).
+ * A NAK (opcode 0, status 'bad frame') names the first sequence number the
+ * device is missing.
+ * @param {number[]|Uint8Array} encoded - COBS bytes between delimiters
+ * @returns {{sequence: number, opcode: number, status: number, accepted: boolean, nak: boolean, text: string}}
+ * @throws {Error} If the frame is malformed or fails its CRC
+ */
+export function decodeReliableResponseFrame(encoded) {
+  const payload = cobsDecode(encoded);
+  if (payload.length !== 4 || crc8(payload.slice(0, 3), 3) !== payload[3]) {
+    throw new Error('Corrupt response frame');
+  }
+
+  const [sequence, opcode, status] = payload;
+  const nak = opcode === 0 && status === 3;
+  const verb = Object.keys(FRAME_COMMANDS).find((name) => FRAME_COMMANDS[name].opcode === opcode);
+  const accepted = status === 0;
+  const text = nak
+    ? `NAK,${sequence}`
+    : accepted
+      ? `ACCEPTED,${verb}`
+      : `REJECT,${verb || 'FRAME'},${FRAME_STATUS[status] || 'unknown error'}`;
+
+  return { sequence, opcode, status, accepted, nak, text };
+}
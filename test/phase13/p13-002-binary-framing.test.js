@@ -0,0 +1,55 @@
+/**
+ * @fileoverview P13-002: Binary Framing Test - Test-Matrix.md Compliant
+ * 
+ * Self-contained test following Test-Matrix.md guidelines.
+ * Tests: framing 'binary' writes a COBS/CRC-8 frame instead of a text line
+ */
+
+import { test, expect, vi } from 'vitest';
+import { LedController } from '../../src/controller.js';
+
+// Mock SerialPort with hoisting-safe approach
+const mockWrite = vi.fn((data, callback) => {
+  if (callback) callback();
+});
+
+const mockSerialPortInstance = {
+  write: mockWrite,
+  close: vi.fn((callback) => { if (callback) callback(); }),
+  on: vi.fn((event, handler) => {
+    if (event === 'data') {
+      // Response frame: opcode 3 (COLOR), status 0, CRC-8
+      setImmediate(() => handler(Buffer.from([0x00, 0x02, 0x03, 0x02, 0x3F, 0x00])));
+    }
+  }),
+  off: vi.fn(),
+  isOpen: true
+};
+
+vi.mock('serialport', () => ({
+  SerialPort: vi.fn((config, callback) => {
+    if (callback) setImmediate(() => callback(null));
+    return mockSerialPortInstance;
+  })
+}));
+
+vi.mock('../../src/utils/config.js', () => ({
+  getSerialPort: vi.fn(() => 'COM3')
+}));
+
+test('P13-002: binary framing sends COLOR as a COBS/CRC-8 frame', async () => {
+  // Clear previous calls
+  vi.clearAllMocks();
+  
+  // Execute: Set red with binary framing enabled
+  const controller = new LedController('COM3', { framing: 'binary' });
+  await controller.connect();
+  await controller.setColor('red');
+  await controller.disconnect();
+  
+  // Assert: Opcode 3, channels 255,0,0, CRC 0x11, zero-free between delimiters
+  expect(mockWrite).toHaveBeenCalledWith(
+    Buffer.from([0x00, 0x03, 0x03, 0xFF, 0x01, 0x02, 0x11, 0x00]),
+    expect.any(Function)
+  );
+});
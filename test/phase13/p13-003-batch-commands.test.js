@@ -0,0 +1,52 @@
+/**
+ * @fileoverview P13-003: Batch Command Test - Test-Matrix.md Compliant
+ * 
+ * Self-contained test following Test-Matrix.md guidelines.
+ * Tests: sendBatch() joins commands into one separator-delimited line
+ */
+
+import { test, expect, vi } from 'vitest';
+import { LedController } from '../../src/controller.js';
+
+// Mock SerialPort with hoisting-safe approach
+const mockWrite = vi.fn((data, callback) => {
+  if (callback) callback();
+});
+
+const mockSerialPortInstance = {
+  write: mockWrite,
+  close: vi.fn((callback) => { if (callback) callback(); }),
+  on: vi.fn((event, handler) => {
+    if (event === 'data') {
+      setImmediate(() => handler(Buffer.from('ACCEPTED,BATCH,3,111')));
+    }
+  }),
+  off: vi.fn(),
+  isOpen: true
+};
+
+vi.mock('serialport', () => ({
+  SerialPort: vi.fn((config, callback) => {
+    if (callback) setImmediate(() => callback(null));
+    return mockSerialPortInstance;
+  })
+}));
+
+vi.mock('../../src/utils/config.js', () => ({
+  getSerialPort: vi.fn(() => 'COM3')
+}));
+
+test('P13-003: sendBatch() sends OFF;COLOR;BLINK1 as a single line', async () => {
+  // Clear previous calls
+  vi.clearAllMocks();
+  
+  // Execute: Apply a compound state change in one round trip
+  const controller = new LedController('COM3');
+  await controller.connect();
+  await controller.sendBatch(['OFF', 'COLOR,255,0,0', 'BLINK1,0,0,255,200']);
+  await controller.disconnect();
+  
+  // Assert: One write carries all three commands
+  expect(mockWrite).toHaveBeenCalledTimes(1);
+  expect(mockWrite).toHaveBeenCalledWith('OFF;COLOR,255,0,0;BLINK1,0,0,255,200\n', expect.any(Function));
+});
@@ -0,0 +1,65 @@
+/**
+ * @fileoverview P13-004: Pipelined Command Test - Test-Matrix.md Compliant
+ * 
+ * Self-contained test following Test-Matrix.md guidelines.
+ * Tests: sendPipelined() tags commands with #<id> and matches responses by tag
+ */
+
+import { test, expect, vi } from 'vitest';
+import { LedController } from '../../src/controller.js';
+
+// Mock SerialPort: answers out of order, two responses coalesced in one chunk
+let dataHandler = null;
+const pendingLines = [];
+
+const mockWrite = vi.fn((data, callback) => {
+  const [tag, verb] = data.trim().split(',');
+  pendingLines.unshift(`ACCEPTED,${tag},${verb}\r\n`);
+  if (pendingLines.length === 2) {
+    const chunk = pendingLines.splice(0).join('');
+    setImmediate(() => dataHandler(Buffer.from(chunk)));
+  }
+  if (callback) callback();
+});
+
+const mockSerialPortInstance = {
+  write: mockWrite,
+  close: vi.fn((callback) => { if (callback) callback(); }),
+  on: vi.fn((event, handler) => {
+    if (event === 'data') dataHandler = handler;
+  }),
+  off: vi.fn(),
+  isOpen: true
+};
+
+vi.mock('serialport', () => ({
+  SerialPort: vi.fn((config, callback) => {
+    if (callback) setImmediate(() => callback(null));
+    return mockSerialPortInstance;
+  })
+}));
+
+vi.mock('../../src/utils/config.js', () => ({
+  getSerialPort: vi.fn(() => 'COM3')
+}));
+
+test('P13-004: sendPipelined() keeps two commands in flight and matches responses by tag', async () => {
+  // Clear previous calls
+  vi.clearAllMocks();
+  
+  // Execute: Four commands through a window of two
+  const controller = new LedController('COM3');
+  await controller.connect();
+  const responses = await controller.sendPipelined(['ON', 'OFF', 'RAINBOW,50', 'OFF'], { window: 2 });
+  await controller.disconnect();
+  
+  // Assert: Tagged lines sent, each response returned in command order
+  expect(mockWrite).toHaveBeenNthCalledWith(1, '#0,ON\n', expect.any(Function));
+  expect(mockWrite).toHaveBeenNthCalledWith(3, '#2,RAINBOW,50\n', expect.any(Function));
+  expect(responses).toEqual([
+    'ACCEPTED,#0,ON',
+    'ACCEPTED,#1,OFF',
+    'ACCEPTED,#2,RAINBOW',
+    'ACCEPTED,#3,OFF'
+  ]);
+});
@@ -0,0 +1,59 @@
+/**
+ * @fileoverview P13-005: Quiet Mode Test - Test-Matrix.md Compliant
+ * 
+ * Self-contained test following Test-Matrix.md guidelines.
+ * Tests: setQuietMode() + sendNoWait() report only REJECT lines via onReject
+ */
+
+import { test, expect, vi } from 'vitest';
+import { LedController } from '../../src/controller.js';
+
+// Mock SerialPort: acknowledges QUIET, stays silent for accepted commands
+const dataHandlers = new Set();
+const emit = (line) => setImmediate(() => dataHandlers.forEach((handler) => handler(Buffer.from(line))));
+
+const mockWrite = vi.fn((data, callback) => {
+  if (data.startsWith('QUIET,')) emit('ACCEPTED,QUIET,1\r\n');
+  if (data.startsWith('COLOR,300')) emit('REJECT,#2,COLOR,invalid format\r\n');
+  if (callback) callback();
+});
+
+const mockSerialPortInstance = {
+  write: mockWrite,
+  close: vi.fn((callback) => { if (callback) callback(); }),
+  on: vi.fn((event, handler) => { if (event === 'data') dataHandlers.add(handler); }),
+  off: vi.fn((event, handler) => dataHandlers.delete(handler)),
+  isOpen: true
+};
+
+vi.mock('serialport', () => ({
+  SerialPort: vi.fn((config, callback) => {
+    if (callback) setImmediate(() => callback(null));
+    return mockSerialPortInstance;
+  })
+}));
+
+vi.mock('../../src/utils/config.js', () => ({
+  getSerialPort: vi.fn(() => 'COM3')
+}));
+
+test('P13-005: quiet mode sends without waiting and maps REJECT sequence numbers to commands', async () => {
+  // Clear previous calls
+  vi.clearAllMocks();
+  const onReject = vi.fn();
+  
+  // Execute: Enable quiet mode, then fire two commands
+  const controller = new LedController('COM3', { onReject });
+  await controller.connect();
+  await controller.setQuietMode();
+  await controller.sendNoWait('ON');
+  await controller.sendNoWait('COLOR,300,0,0');
+  await new Promise((resolve) => setImmediate(resolve));
+  await controller.disconnect();
+  
+  // Assert: QUIET,1 sent, commands written as plain lines, only the reject reported
+  expect(mockWrite).toHaveBeenNthCalledWith(1, 'QUIET,1\n', expect.any(Function));
+  expect(mockWrite).toHaveBeenNthCalledWith(2, 'ON\n', expect.any(Function));
+  expect(onReject).toHaveBeenCalledTimes(1);
+  expect(onReject).toHaveBeenCalledWith('REJECT,#2,COLOR,invalid format', 'COLOR,300,0,0');
+});
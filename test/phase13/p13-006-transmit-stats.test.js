@@ -0,0 +1,53 @@
+/**
+ * @fileoverview P13-006: Transmit Statistics Test - Test-Matrix.md Compliant
+ * 
+ * Self-contained test following Test-Matrix.md guidelines.
+ * Tests: getStats() sends STATS and parses the TX ring counters
+ */
+
+import { test, expect, vi } from 'vitest';
+import { LedController } from '../../src/controller.js';
+
+// Mock SerialPort: answers a tagged STATS query
+const dataHandlers = new Set();
+const emit = (line) => setImmediate(() => dataHandlers.forEach((handler) => handler(Buffer.from(line))));
+
+const mockWrite = vi.fn((data, callback) => {
+  const match = /^#(\d+),STATS\n$/.exec(data);
+  if (match) emit(`ACCEPTED,#${match[1]},STATS,tx_high=412,tx_size=1024,tx_stalls=2\r\n`);
+  if (callback) callback();
+});
+
+const mockSerialPortInstance = {
+  write: mockWrite,
+  close: vi.fn((callback) => { if (callback) callback(); }),
+  on: vi.fn((event, handler) => { if (event === 'data') dataHandlers.add(handler); }),
+  off: vi.fn((event, handler) => dataHandlers.delete(handler)),
+  isOpen: true
+};
+
+vi.mock('serialport', () => ({
+  SerialPort: vi.fn((config, callback) => {
+    if (callback) setImmediate(() => callback(null));
+    return mockSerialPortInstance;
+  })
+}));
+
+vi.mock('../../src/utils/config.js', () => ({
+  getSerialPort: vi.fn(() => 'COM3')
+}));
+
+test('P13-006: getStats returns the device transmit counters', async () => {
+  // Clear previous calls
+  vi.clearAllMocks();
+  
+  // Execute: Query the counters
+  const controller = new LedController('COM3');
+  await controller.connect();
+  const stats = await controller.getStats();
+  await controller.disconnect();
+  
+  // Assert: STATS sent as a tagged line, fields parsed as numbers
+  expect(mockWrite).toHaveBeenCalledWith(expect.stringMatching(/^#\d+,STATS\n$/), expect.any(Function));
+  expect(stats).toEqual({ tx_high: 412, tx_size: 1024, tx_stalls: 2 });
+});
@@ -0,0 +1,67 @@
+/**
+ * @fileoverview P13-007: Baud Rate Negotiation Test - Test-Matrix.md Compliant
+ * 
+ * Self-contained test following Test-Matrix.md guidelines.
+ * Tests: negotiateBaudRate() switches after BAUD + PING and falls back when PING fails
+ */
+
+import { test, expect, vi } from 'vitest';
+import { LedController } from '../../src/controller.js';
+
+// Mock SerialPort: acknowledges BAUD, answers PING only at rates up to 115200
+const dataHandlers = new Set();
+const emit = (line) => setImmediate(() => dataHandlers.forEach((handler) => handler(Buffer.from(line))));
+let portRate = 9600;
+
+const mockWrite = vi.fn((data, callback) => {
+  const match = /^#(\d+),(BAUD,\d+|PING)\n$/.exec(data);
+  if (match && (match[2] !== 'PING' || portRate <= 115200)) emit(`ACCEPTED,#${match[1]},${match[2]}\r\n`);
+  if (callback) callback();
+});
+
+const mockUpdate = vi.fn((settings, callback) => {
+  portRate = settings.baudRate;
+  if (callback) callback(null);
+});
+
+const mockSerialPortInstance = {
+  write: mockWrite,
+  update: mockUpdate,
+  close: vi.fn((callback) => { if (callback) callback(); }),
+  on: vi.fn((event, handler) => { if (event === 'data') dataHandlers.add(handler); }),
+  off: vi.fn((event, handler) => dataHandlers.delete(handler)),
+  isOpen: true
+};
+
+vi.mock('serialport', () => ({
+  SerialPort: vi.fn((config, callback) => {
+    if (callback) setImmediate(() => callback(null));
+    return mockSerialPortInstance;
+  })
+}));
+
+vi.mock('../../src/utils/config.js', () => ({
+  getSerialPort: vi.fn(() => 'COM3')
+}));
+
+test('P13-007: negotiateBaudRate switches on a confirmed PING and falls back otherwise', async () => {
+  // Clear previous calls
+  vi.clearAllMocks();
+  
+  // Execute: One confirmed switch, then one that is never confirmed
+  const controller = new LedController('COM3');
+  await controller.connect();
+  const switched = await controller.negotiateBaudRate(115200);
+  const rateAfterSwitch = controller.baudRate;
+  const fallback = await controller.negotiateBaudRate(230400);
+  await controller.disconnect();
+  
+  // Assert: BAUD then PING; the failed rate is undone on the port
+  expect(switched).toBe(true);
+  expect(rateAfterSwitch).toBe(115200);
+  expect(mockWrite.mock.calls[0][0]).toMatch(/^#\d+,BAUD,115200\n$/);
+  expect(mockWrite.mock.calls[1][0]).toMatch(/^#\d+,PING\n$/);
+  expect(fallback).toBe(false);
+  expect(mockUpdate.mock.calls.map(([settings]) => settings.baudRate)).toEqual([115200, 230400, 115200]);
+  expect(controller.baudRate).toBe(115200);
+});
@@ -0,0 +1,61 @@
+/**
+ * @fileoverview P13-008: Flow Control Test - Test-Matrix.md Compliant
+ * 
+ * Self-contained test following Test-Matrix.md guidelines.
+ * Tests: setFlowControl() + sendNoWait() send only while credits are held
+ */
+
+import { test, expect, vi } from 'vitest';
+import { LedController } from '../../src/controller.js';
+
+// Mock SerialPort: a device with a 2-slot queue that grants credits on FLOW,1
+const dataHandlers = new Set();
+const emit = (line) => setImmediate(() => dataHandlers.forEach((handler) => handler(Buffer.from(line))));
+
+const mockWrite = vi.fn((data, callback) => {
+  const match = /^#(\d+),FLOW,1\n$/.exec(data);
+  if (match) emit(`ACCEPTED,#${match[1]},FLOW,1\r\nCREDIT,2\r\n`);
+  if (callback) callback();
+});
+
+const mockSerialPortInstance = {
+  write: mockWrite,
+  close: vi.fn((callback) => { if (callback) callback(); }),
+  on: vi.fn((event, handler) => { if (event === 'data') dataHandlers.add(handler); }),
+  off: vi.fn((event, handler) => dataHandlers.delete(handler)),
+  isOpen: true
+};
+
+vi.mock('serialport', () => ({
+  SerialPort: vi.fn((config, callback) => {
+    if (callback) setImmediate(() => callback(null));
+    return mockSerialPortInstance;
+  })
+}));
+
+vi.mock('../../src/utils/config.js', () => ({
+  getSerialPort: vi.fn(() => 'COM3')
+}));
+
+test('P13-008: flow control holds commands until the device grants credit', async () => {
+  // Clear previous calls
+  vi.clearAllMocks();
+  
+  // Execute: Enable flow control, then stream three commands against two credits
+  const controller = new LedController('COM3');
+  await controller.connect();
+  await controller.setFlowControl();
+  const sends = ['ON', 'OFF', 'RAINBOW,50'].map((command) => controller.sendNoWait(command));
+  await new Promise((resolve) => setImmediate(resolve));
+  const writesBeforeCredit = mockWrite.mock.calls.length;
+  
+  emit('CREDIT,1\r\n');
+  await Promise.all(sends);
+  await controller.disconnect();
+  
+  // Assert: FLOW,1 then two commands; the third waits for CREDIT,1
+  expect(mockWrite.mock.calls[0][0]).toMatch(/^#\d+,FLOW,1\n$/);
+  expect(writesBeforeCredit).toBe(3);
+  expect(mockWrite).toHaveBeenNthCalledWith(4, 'RAINBOW,50\n', expect.any(Function));
+  expect(controller.credits).toBe(0);
+});
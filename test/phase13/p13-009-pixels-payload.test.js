@@ -0,0 +1,66 @@
+/**
+ * @fileoverview P13-009: Pixel Payload Test - Test-Matrix.md Compliant
+ *
+ * Self-contained test following Test-Matrix.md guidelines.
+ * Tests: setPixels() sends a whole strip as PIXELS commands sized by payload_max
+ */
+
+import { test, expect, vi } from 'vitest';
+import { LedController } from '../../src/controller.js';
+
+// Mock SerialPort: acknowledges PIXELS lines and answers STATS with a payload limit
+const dataHandlers = new Set();
+const emit = (line) => setImmediate(() => dataHandlers.forEach((handler) => handler(Buffer.from(line))));
+
+const mockWrite = vi.fn((data, callback) => {
+  const stats = /^#(\d+),STATS\n$/.exec(data);
+  if (stats) {
+    emit(`ACCEPTED,#${stats[1]},STATS,tx_high=0,tx_size=1024,tx_stalls=0,payload_max=12\r\n`);
+  }
+  const pixels = /^PIXELS,(\d+),([0-9A-F]+)\n$/.exec(data);
+  if (pixels) emit(`ACCEPTED,PIXELS,${pixels[1]},count=${pixels[2].length / 6}\r\n`);
+  if (callback) callback();
+});
+
+const mockSerialPortInstance = {
+  write: mockWrite,
+  close: vi.fn((callback) => { if (callback) callback(); }),
+  on: vi.fn((event, handler) => { if (event === 'data') dataHandlers.add(handler); }),
+  off: vi.fn((event, handler) => dataHandlers.delete(handler)),
+  isOpen: true
+};
+
+vi.mock('serialport', () => ({
+  SerialPort: vi.fn((config, callback) => {
+    if (callback) setImmediate(() => callback(null));
+    return mockSerialPortInstance;
+  })
+}));
+
+vi.mock('../../src/utils/config.js', () => ({
+  getSerialPort: vi.fn(() => 'COM3')
+}));
+
+test('P13-009: setPixels sends one PIXELS command per payload_max bytes', async () => {
+  // Clear previous calls
+  vi.clearAllMocks();
+  
+  // Execute: One command for a short strip, then split after STATS lowers the limit
+  const controller = new LedController('COM3');
+  await controller.connect();
+  await controller.setPixels(['red', '0,255,0', 'blue']);
+  const stats = await controller.getStats();
+  await controller.setPixels(['red', 'red', 'red', 'red', 'green', 'green'], 10);
+  await controller.disconnect();
+  
+  // Assert: Hex payload per pixel, 12-byte payloads hold four pixels
+  const lines = mockWrite.mock.calls.map(([data]) => data).filter((data) => data.startsWith('PIXELS'));
+  expect(stats.payload_max).toBe(12);
+  expect(lines).toEqual([
+    'PIXELS,0,FF000000FF000000FF\n',
+    'PIXELS,10,FF0000FF0000FF0000FF0000\n',
+    'PIXELS,14,00FF0000FF00\n'
+  ]);
+  await expect(controller.setPixels([], 0)).rejects.toThrow('At least one pixel');
+  await expect(controller.setPixels(['red'], 65536)).rejects.toThrow('Invalid pixel range');
+});
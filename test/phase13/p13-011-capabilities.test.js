@@ -0,0 +1,77 @@
+/**
+ * @fileoverview P13-011: Capabilities Test - Test-Matrix.md Compliant
+ *
+ * Self-contained test following Test-Matrix.md guidelines.
+ * Tests: getCapabilities() parses CAPS once per port and gates unsupported commands
+ */
+
+import { test, expect, vi } from 'vitest';
+import { LedController } from '../../src/controller.js';
+
+// Mock SerialPort: a single-color LED on an AVR board
+const dataHandlers = new Set();
+const emit = (line) => setImmediate(() => dataHandlers.forEach((handler) => handler(Buffer.from(line))));
+
+const mockWrite = vi.fn((data, callback) => {
+  const caps = /^#(\d+),CAPS\n$/.exec(data);
+  if (caps) {
+    emit(`ACCEPTED,#${caps[1]},CAPS,proto=1,led=Digital,pixels=1,rx=64,baud_max=115200,verbs=DF96\r\n`);
+  } else if (!data.startsWith('#')) {
+    emit(`ACCEPTED,${data.trim()}\r\n`);
+  }
+  if (callback) callback();
+});
+
+const mockSerialPortInstance = {
+  write: mockWrite,
+  close: vi.fn((callback) => { if (callback) callback(); }),
+  on: vi.fn((event, handler) => { if (event === 'data') dataHandlers.add(handler); }),
+  off: vi.fn((event, handler) => dataHandlers.delete(handler)),
+  isOpen: true
+};
+
+vi.mock('serialport', () => ({
+  SerialPort: vi.fn((config, callback) => {
+    if (callback) setImmediate(() => callback(null));
+    return mockSerialPortInstance;
+  })
+}));
+
+vi.mock('../../src/utils/config.js', () => ({
+  getSerialPort: vi.fn(() => 'COM3')
+}));
+
+test('P13-011: getCapabilities caches CAPS per port and refuses unsupported commands', async () => {
+  // Clear previous calls
+  vi.clearAllMocks();
+  
+  // Execute: Query once, then reuse the cached result from a second controller
+  const first = new LedController('COM3');
+  await first.connect();
+  const caps = await first.getCapabilities();
+  await first.disconnect();
+  
+  const controller = new LedController('COM3');
+  await controller.connect();
+  await controller.blink('red', 250);
+  await expect(controller.setColor('red')).rejects.toThrow('COLOR is not supported by this device (Digital LED)');
+  await expect(controller.rainbow(50)).rejects.toThrow('RAINBOW is not supported');
+  await expect(controller.sendBatch(['OFF', 'BLINK2,255,0,0,0,0,255,500'])).rejects.toThrow('BLINK2 is not supported');
+  await expect(controller.setPixels(['red', 'blue'])).rejects.toThrow('Invalid pixel range');
+  const switched = await controller.negotiateBaudRate(230400);
+  await controller.disconnect();
+  
+  // Assert: One CAPS query, refused commands never written
+  const writes = mockWrite.mock.calls.map(([data]) => data);
+  expect(caps).toEqual({
+    protocol: 1,
+    led: 'Digital',
+    pixels: 1,
+    rxSize: 64,
+    baudMax: 115200,
+    verbs: new Set(['ON', 'OFF', 'BLINK1', 'ECHO', 'QUIET', 'STATS', 'BAUD', 'PING', 'FLOW', 'RELIABLE', 'CAPS'])
+  });
+  expect(controller.capabilities).toBe(caps);
+  expect(switched).toBe(false);
+  expect(writes).toEqual(['#0,CAPS\n', 'BLINK1,255,255,255,250\n']);
+});
@@ -0,0 +1,64 @@
+/**
+ * @fileoverview P13-012: Fill Test - Test-Matrix.md Compliant
+ *
+ * Self-contained test following Test-Matrix.md guidelines.
+ * Tests: fill() addresses a run of the strip, defaulting to every pixel CAPS reports
+ */
+
+import { test, expect, vi } from 'vitest';
+import { LedController } from '../../src/controller.js';
+import { cobsDecode, encodeCommandFrame } from '../../src/utils/frame-codec.js';
+
+// Mock SerialPort: a 60-pixel RGB strip
+const dataHandlers = new Set();
+const emit = (line) => setImmediate(() => dataHandlers.forEach((handler) => handler(Buffer.from(line))));
+
+const mockWrite = vi.fn((data, callback) => {
+  const caps = /^#(\d+),CAPS\n$/.exec(data);
+  if (caps) {
+    emit(`ACCEPTED,#${caps[1]},CAPS,proto=1,led=RGB,pixels=60,rx=1024,baud_max=921600,verbs=3FFFE\r\n`);
+  } else if (!data.startsWith('#')) {
+    emit(`ACCEPTED,${data.trim()}\r\n`);
+  }
+  if (callback) callback();
+});
+
+const mockSerialPortInstance = {
+  write: mockWrite,
+  close: vi.fn((callback) => { if (callback) callback(); }),
+  on: vi.fn((event, handler) => { if (event === 'data') dataHandlers.add(handler); }),
+  off: vi.fn((event, handler) => dataHandlers.delete(handler)),
+  isOpen: true
+};
+
+vi.mock('serialport', () => ({
+  SerialPort: vi.fn((config, callback) => {
+    if (callback) setImmediate(() => callback(null));
+    return mockSerialPortInstance;
+  })
+}));
+
+vi.mock('../../src/utils/config.js', () => ({
+  getSerialPort: vi.fn(() => 'COM3')
+}));
+
+test('P13-012: fill covers the whole strip by default and one run on request', async () => {
+  // Clear previous calls
+  vi.clearAllMocks();
+  
+  // Execute: Whole strip, then a run, then a run past the end
+  const controller = new LedController('COM3');
+  await controller.connect();
+  await controller.getCapabilities();
+  await controller.fill('red');
+  await controller.fill('0,0,255', 10, 5);
+  await expect(controller.fill('green', 60)).rejects.toThrow('Invalid pixel range');
+  await expect(controller.fill('green', 0, 0)).rejects.toThrow('Invalid pixel range');
+  await controller.disconnect();
+  
+  // Assert: One FILL per call; the binary form packs 2-byte start and count
+  const writes = mockWrite.mock.calls.map(([data]) => data);
+  expect(writes).toEqual(['#0,CAPS\n', 'FILL,0,60,255,0,0\n', 'FILL,10,5,0,0,255\n']);
+  const frame = encodeCommandFrame('FILL,300,300,0,255,0');
+  expect(cobsDecode(frame.subarray(1, frame.length - 1)).slice(0, 8)).toEqual([16, 0x2C, 0x01, 0x2C, 0x01, 0, 255, 0]);
+});
@@ -0,0 +1,58 @@
+/**
+ * @fileoverview P13-013: Fade Test - Test-Matrix.md Compliant
+ *
+ * Self-contained test following Test-Matrix.md guidelines.
+ * Tests: fade() sends one FADE command with the easing's wire value
+ */
+
+import { test, expect, vi } from 'vitest';
+import { LedController } from '../../src/controller.js';
+import { cobsDecode, encodeCommandFrame } from '../../src/utils/frame-codec.js';
+
+// Mock SerialPort: acknowledges every command
+const dataHandlers = new Set();
+const emit = (line) => setImmediate(() => dataHandlers.forEach((handler) => handler(Buffer.from(line))));
+
+const mockWrite = vi.fn((data, callback) => {
+  emit(`ACCEPTED,${data.trim()}\r\n`);
+  if (callback) callback();
+});
+
+const mockSerialPortInstance = {
+  write: mockWrite,
+  close: vi.fn((callback) => { if (callback) callback(); }),
+  on: vi.fn((event, handler) => { if (event === 'data') dataHandlers.add(handler); }),
+  off: vi.fn((event, handler) => dataHandlers.delete(handler)),
+  isOpen: true
+};
+
+vi.mock('serialport', () => ({
+  SerialPort: vi.fn((config, callback) => {
+    if (callback) setImmediate(() => callback(null));
+    return mockSerialPortInstance;
+  })
+}));
+
+vi.mock('../../src/utils/config.js', () => ({
+  getSerialPort: vi.fn(() => 'COM3')
+}));
+
+test('P13-013: fade sends a single FADE with duration and easing', async () => {
+  // Clear previous calls
+  vi.clearAllMocks();
+  
+  // Execute: Default easing, an eased fade, then invalid arguments
+  const controller = new LedController('COM3');
+  await controller.connect();
+  await controller.fade('blue', 800);
+  await controller.fade('255,128,0', 1500, 'ease-in-out');
+  await expect(controller.fade('red', 70000)).rejects.toThrow('Invalid fade duration');
+  await expect(controller.fade('red', 500, 'bounce')).rejects.toThrow('Invalid easing');
+  await controller.disconnect();
+  
+  // Assert: One command per fade; the binary form packs a 2-byte duration
+  const writes = mockWrite.mock.calls.map(([data]) => data);
+  expect(writes).toEqual(['FADE,0,0,255,800,0\n', 'FADE,255,128,0,1500,3\n']);
+  const frame = encodeCommandFrame('FADE,0,0,255,1500,3');
+  expect(cobsDecode(frame.subarray(1, frame.length - 1)).slice(0, 7)).toEqual([17, 0, 0, 255, 0xDC, 0x05, 3]);
+});
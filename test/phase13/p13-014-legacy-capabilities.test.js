@@ -0,0 +1,65 @@
+/**
+ * @fileoverview P13-014: Legacy Capabilities Test - Test-Matrix.md Compliant
+ *
+ * Self-contained test following Test-Matrix.md guidelines.
+ * Tests: executeCommand() queries CAPS once per port and limits firmware that rejects or ignores it to the original verbs
+ */
+
+import { test, expect, vi } from 'vitest';
+import { executeCommand } from '../../src/controller.js';
+
+// Mock SerialPort: firmware without sequence tags or CAPS. On COM3 it rejects
+// the tagged query untagged; on COM4 it never answers it.
+const dataHandlers = new Set();
+const emit = (line) => setImmediate(() => dataHandlers.forEach((handler) => handler(Buffer.from(line))));
+let portName = null;
+
+const mockWrite = vi.fn((data, callback) => {
+  if (!data.startsWith('#')) {
+    emit(`ACCEPTED,${data.trim()}\r\n`);
+  } else if (portName === 'COM3') {
+    emit('REJECT,,unknown command\r\n');
+  }
+  if (callback) callback();
+});
+
+const mockSerialPortInstance = {
+  write: mockWrite,
+  close: vi.fn((callback) => { if (callback) callback(); }),
+  on: vi.fn((event, handler) => { if (event === 'data') dataHandlers.add(handler); }),
+  off: vi.fn((event, handler) => dataHandlers.delete(handler)),
+  update: vi.fn((options, callback) => { if (callback) callback(); }),
+  isOpen: true
+};
+
+vi.mock('serialport', () => ({
+  SerialPort: vi.fn((config, callback) => {
+    portName = config.path;
+    if (callback) setImmediate(() => callback(null));
+    return mockSerialPortInstance;
+  })
+}));
+
+vi.mock('../../src/utils/config.js', () => ({
+  getSerialPort: vi.fn(() => 'COM3')
+}));
+
+test('P13-014: executeCommand limits firmware without CAPS to the original verbs', async () => {
+  // Clear previous calls
+  vi.clearAllMocks();
+  
+  // Execute: Rejected CAPS, then commands on the same port
+  await expect(executeCommand({ port: 'COM3', color: 'red', fade: 500 }))
+    .rejects.toThrow('FADE is not supported by this device (legacy LED)');
+  await executeCommand({ port: 'COM3', color: 'red', baud: 115200 });
+  const rejectedWrites = mockWrite.mock.calls.map(([data]) => data);
+  
+  // Execute: Unanswered CAPS on another port
+  mockWrite.mockClear();
+  await executeCommand({ port: 'COM4', on: true });
+  const silentWrites = mockWrite.mock.calls.map(([data]) => data);
+  
+  // Assert: One query per port before the first command; FADE and BAUD never written
+  expect(rejectedWrites).toEqual(['#0,CAPS\n', 'COLOR,255,0,0\n']);
+  expect(silentWrites).toEqual(['#0,CAPS\n', 'ON\n']);
+});
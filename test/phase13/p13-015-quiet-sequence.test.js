@@ -0,0 +1,75 @@
+/**
+ * @fileoverview P13-015: Quiet Sequence Test - Test-Matrix.md Compliant
+ *
+ * Self-contained test following Test-Matrix.md guidelines.
+ * Tests: sendNoWait() counts only the commands the device counts in quiet mode
+ */
+
+import { test, expect, vi } from 'vitest';
+import { LedController } from '../../src/controller.js';
+
+// Mock SerialPort: numbers counted commands like the firmware, answers
+// exempt ones, and rejects every COLOR,300
+const dataHandlers = new Set();
+const emit = (line) => setImmediate(() => dataHandlers.forEach((handler) => handler(Buffer.from(line))));
+const EXEMPT = ['QUIET', 'STATS', 'BAUD', 'PING', 'FLOW', 'RELIABLE', 'CAPS'];
+let sequence = 0;
+
+const mockWrite = vi.fn((data, callback) => {
+  const verb = data.split(';').pop().split(',')[0].trim();
+  if (data.startsWith('QUIET,')) {
+    sequence = 0;
+    emit('ACCEPTED,QUIET,1\r\n');
+  } else if (EXEMPT.includes(verb)) {
+    emit(`ACCEPTED,${data.trim()}\r\n`);
+  } else {
+    sequence++;
+    if (data.startsWith('COLOR,300')) emit(`REJECT,#${sequence},COLOR,invalid format\r\n`);
+  }
+  if (callback) callback();
+});
+
+const mockSerialPortInstance = {
+  write: mockWrite,
+  close: vi.fn((callback) => { if (callback) callback(); }),
+  on: vi.fn((event, handler) => { if (event === 'data') dataHandlers.add(handler); }),
+  off: vi.fn((event, handler) => dataHandlers.delete(handler)),
+  isOpen: true
+};
+
+vi.mock('serialport', () => ({
+  SerialPort: vi.fn((config, callback) => {
+    if (callback) setImmediate(() => callback(null));
+    return mockSerialPortInstance;
+  })
+}));
+
+vi.mock('../../src/utils/config.js', () => ({
+  getSerialPort: vi.fn(() => 'COM3')
+}));
+
+test('P13-015: exempt commands do not shift quiet-mode sequence numbers', async () => {
+  // Clear previous calls
+  vi.clearAllMocks();
+  const onReject = vi.fn();
+  
+  // Execute: Counted and exempt commands interleaved, two rejects
+  const controller = new LedController('COM3', { onReject });
+  await controller.connect();
+  await controller.setQuietMode();
+  await controller.sendNoWait('ON');
+  await controller.sendNoWait('STATS');
+  await controller.sendNoWait('PING');
+  await controller.sendNoWait('COLOR,300,0,0');
+  await controller.sendNoWait('OFF;RAINBOW,50');
+  await controller.sendNoWait('CAPS');
+  await controller.sendNoWait('COLOR,300,1,1');
+  await new Promise((resolve) => setImmediate(resolve));
+  await controller.disconnect();
+  
+  // Assert: Each reject maps back to the command that caused it
+  expect(onReject).toHaveBeenCalledTimes(2);
+  expect(onReject).toHaveBeenNthCalledWith(1, 'REJECT,#2,COLOR,invalid format', 'COLOR,300,0,0');
+  expect(onReject).toHaveBeenNthCalledWith(2, 'REJECT,#4,COLOR,invalid format', 'COLOR,300,1,1');
+  expect(controller.quietSequence).toBe(4);
+});
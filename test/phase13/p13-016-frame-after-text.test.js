@@ -0,0 +1,58 @@
+/**
+ * @fileoverview P13-016: Frame After Text Test - Test-Matrix.md Compliant
+ *
+ * Self-contained test following Test-Matrix.md guidelines.
+ * Tests: a binary response is decoded even when text lines arrive ahead of it
+ */
+
+import { test, expect, vi } from 'vitest';
+import { LedController } from '../../src/controller.js';
+
+// Mock SerialPort: a CREDIT line and a quiet-mode reject precede the
+// response frame, which arrives split across two chunks
+const mockWrite = vi.fn((data, callback) => {
+  if (callback) callback();
+});
+
+const mockSerialPortInstance = {
+  write: mockWrite,
+  close: vi.fn((callback) => { if (callback) callback(); }),
+  on: vi.fn((event, handler) => {
+    if (event === 'data') {
+      setImmediate(() => {
+        handler(Buffer.from('CREDIT,3\r\nREJECT,#2,COLOR,invalid format\r\n'));
+        handler(Buffer.from([0x00, 0x02, 0x03]));
+        handler(Buffer.from([0x02, 0x3F, 0x00]));
+      });
+    }
+  }),
+  off: vi.fn(),
+  isOpen: true
+};
+
+vi.mock('serialport', () => ({
+  SerialPort: vi.fn((config, callback) => {
+    if (callback) setImmediate(() => callback(null));
+    return mockSerialPortInstance;
+  })
+}));
+
+vi.mock('../../src/utils/config.js', () => ({
+  getSerialPort: vi.fn(() => 'COM3')
+}));
+
+test('P13-016: text ahead of a response frame is skipped, not decoded', async () => {
+  // Clear previous calls
+  vi.clearAllMocks();
+  const log = vi.spyOn(console, 'log');
+  
+  // Execute: Set red with binary framing enabled
+  const controller = new LedController('COM3', { framing: 'binary' });
+  await controller.connect();
+  await controller.setColor('red');
+  await controller.disconnect();
+  
+  // Assert: The frame decodes as the COLOR acknowledgement
+  expect(log).toHaveBeenCalledWith('Device response: ACCEPTED,COLOR');
+  log.mockRestore();
+});
@@ -140,6 +140,9 @@ function parseLedOptions(args) {
       case '-r':
         options.rainbow = true;
         break;
+      case '--fade':
+        options.fade = args[++i];
+        break;
     }
   }
   
@@ -357,4 +360,29 @@ test('E1-010: CLI handles multiple boolean flags correctly', async () => {
   expect(callArgs.off).toBe(true);
   expect(callArgs.rainbow).toBe(true);
   // Priority handling is done in controller, not CLI parser
-});
\ No newline at end of file
+});
+
+test('E1-011: CLI parses led --color --fade; fade becomes number', async () => {
+  const dependencies = createMockDependencies();
+  const options = createMockOptions();
+  
+  await executeCLICommand(['node', 'cli', 'led', '--port', 'COM3', '--color', 'blue', '--fade', '65535'], dependencies, options);
+
+  expect(dependencies.controller.executeCommand).toHaveBeenCalledTimes(1);
+  const callArgs = dependencies.controller.executeCommand.mock.calls[0][0];
+  expect(callArgs.color).toBe('blue');
+  expect(callArgs.fade).toBe(65535);
+});
+
+test('E1-012: CLI rejects a fade duration that is not an integer in 0-65535', async () => {
+  for (const fade of ['abc', '12abc', '1.5', '-1', '', '65536']) {
+    const dependencies = createMockDependencies();
+    const options = createMockOptions();
+    
+    await executeCLICommand(['node', 'cli', 'led', '--port', 'COM3', '--color', 'blue', '--fade', fade], dependencies, options);
+
+    expect(dependencies.controller.executeCommand).not.toHaveBeenCalled();
+    expect(options.exitHandler).toHaveBeenCalledWith(1);
+    expect(options.consoleHandler.error).toHaveBeenCalledWith(expect.stringContaining(`Invalid fade duration ${fade}`));
+  }
+});